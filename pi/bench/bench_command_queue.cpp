@@ -0,0 +1,86 @@
+// bench/bench_command_queue.cpp
+#include <benchmark/benchmark.h>
+#include "mpsc_queue.hpp"
+#include "state_machine.hpp"
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Previous design: std::queue guarded by a mutex
+class MutexCommandQueue {
+public:
+    bool tryPush(Command cmd) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push(cmd);
+        return true;
+    }
+    bool tryPop(Command& cmd) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) return false;
+        cmd = queue.front();
+        queue.pop();
+        return true;
+    }
+private:
+    std::mutex mutex;
+    std::queue<Command> queue;
+};
+
+// P producer threads push while one consumer drains, like MQTT callbacks feeding update().
+// Reports throughput and the worst time a consumer drain spent inside the queue.
+template <typename Queue>
+static void runContention(benchmark::State& state)
+{
+    const int producers = static_cast<int>(state.range(0));
+    constexpr int PER_PRODUCER = 10000;
+    int64_t failedPushes = 0;
+    double worstPopNs = 0.0;
+
+    for (auto _ : state) {
+        Queue queue;
+        std::atomic<bool> go{false};
+        std::atomic<int64_t> failed{0};
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&]() {
+                while (!go.load(std::memory_order_acquire)) {}
+                int64_t localFailed = 0;
+                for (int i = 0; i < PER_PRODUCER; ++i)
+                    while (!queue.tryPush(Command::START_AUTO)) { ++localFailed; std::this_thread::yield(); }
+                failed.fetch_add(localFailed);
+            });
+        }
+
+        go.store(true, std::memory_order_release);
+        int received = 0;
+        Command cmd;
+        while (received < producers * PER_PRODUCER) {
+            auto start = std::chrono::steady_clock::now();
+            bool popped = queue.tryPop(cmd);
+            std::chrono::duration<double, std::nano> spent = std::chrono::steady_clock::now() - start;
+            worstPopNs = std::max(worstPopNs, spent.count());
+            if (popped) ++received;
+            else std::this_thread::yield(); // idle consumer, like a control loop with nothing queued
+        }
+        for (auto& t : threads) t.join();
+        failedPushes += failed.load();
+    }
+
+    state.SetItemsProcessed(state.iterations() * producers * PER_PRODUCER);
+    state.counters["producers"] = producers;
+    state.counters["full_retries"] = static_cast<double>(failedPushes);
+    state.counters["worst_pop_ns"] = worstPopNs;
+}
+
+static void BM_MutexCommandQueue(benchmark::State& state)
+{
+    runContention<MutexCommandQueue>(state);
+}
+BENCHMARK(BM_MutexCommandQueue)->DenseRange(1, 4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_MpscCommandQueue(benchmark::State& state)
+{
+    runContention<MpscQueue<Command, 64>>(state);
+}
+BENCHMARK(BM_MpscCommandQueue)->DenseRange(1, 4)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,66 @@
+// bench/bench_config_store.cpp
+#include <benchmark/benchmark.h>
+#include "config_store.hpp"
+#include "state_machine.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+// Previous design: getConfig() copied the config under a mutex
+class MutexConfig {
+public:
+    explicit MutexConfig(const IrrigationConfig& config) : config(config) {}
+    IrrigationConfig get() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return config;
+    }
+    void update(const IrrigationConfig& newconfig) {
+        std::lock_guard<std::mutex> lock(mutex);
+        config = newconfig;
+    }
+private:
+    mutable std::mutex mutex;
+    IrrigationConfig config;
+};
+
+static double readThreshold(MutexConfig& store) { return store.get().lowMoistureThreshold; }
+static double readThreshold(ConfigStore<IrrigationConfig>& store) { return store.pin().value.lowMoistureThreshold; }
+
+// Control-loop read path while a writer republishes the config every `range(0)` microseconds
+// (0 = no writer). Reports the number of updates that landed during the run.
+template <typename Store>
+static void runReadPath(benchmark::State& state)
+{
+    const auto writePeriod = std::chrono::microseconds(state.range(0));
+    IrrigationConfig config = IrrigationConfig::forLoam("Bench Zone");
+    Store store(config);
+
+    std::atomic<bool> stop{false};
+    std::atomic<int64_t> updates{0};
+    std::thread writer;
+    if (writePeriod.count() > 0) {
+        writer = std::thread([&]() {
+            IrrigationConfig next = config;
+            while (!stop.load(std::memory_order_relaxed)) {
+                next.lowMoistureThreshold = next.lowMoistureThreshold > 30.0 ? 25.0 : 35.0;
+                store.update(next);
+                updates.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::sleep_for(writePeriod);
+            }
+        });
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(readThreshold(store));
+    }
+
+    stop = true;
+    if (writer.joinable()) writer.join();
+    state.counters["updates"] = static_cast<double>(updates.load());
+}
+
+static void BM_ConfigRead_MutexCopy(benchmark::State& state) { runReadPath<MutexConfig>(state); }
+static void BM_ConfigRead_Snapshot(benchmark::State& state) { runReadPath<ConfigStore<IrrigationConfig>>(state); }
+BENCHMARK(BM_ConfigRead_MutexCopy)->Arg(0)->Arg(100)->Arg(10);
+BENCHMARK(BM_ConfigRead_Snapshot)->Arg(0)->Arg(100)->Arg(10);
@@ -0,0 +1,103 @@
+// bench/bench_emergency_stop.cpp
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+#include "zone_manager.hpp"
+#include "simulated_hardware.hpp"
+#include "clock.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// Pump that remembers when it was last switched off
+class TimedPump : public IPumpInterface {
+public:
+    bool initialize() override { return true; }
+    void activate() override { running.store(true); }
+    void deactivate() override {
+        offAt.store(std::chrono::steady_clock::now().time_since_epoch().count());
+        running.store(false);
+    }
+    bool isActive() override { return running.load(); }
+
+    std::chrono::steady_clock::time_point lastOff() const {
+        return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(offAt.load()));
+    }
+    void clear() { offAt.store(0); }
+
+    std::atomic<bool> running{false};
+    std::atomic<std::chrono::steady_clock::rep> offAt{0};
+};
+
+// MQTT "STOP" message arrival to pump->deactivate(), on the callback thread.
+// range(0) = 1 runs the control loop flat out on another thread at the same time.
+static void BM_EmergencyStop_FastPath(benchmark::State& state)
+{
+    spdlog::set_level(spdlog::level::off);
+    const bool busyControl = state.range(0) != 0;
+    SimulatedHardware sensor;
+    TimedPump pump;
+    ZoneManager manager;
+    manager.addZone(IrrigationConfig::forLoam("Bench Zone"), &sensor, &pump);
+    const std::string topic = ZoneManager::commandTopic(0);
+
+    std::atomic<bool> stop{false};
+    std::thread control;
+    if (busyControl) {
+        control = std::thread([&]() {
+            while (!stop.load(std::memory_order_relaxed)) manager.updateAll();
+        });
+    }
+
+    for (auto _ : state) {
+        pump.clear();
+        auto arrived = std::chrono::steady_clock::now();
+        manager.handleMessage(topic, "STOP");
+        std::chrono::duration<double> latency = pump.lastOff() - arrived;
+        state.SetIterationTime(latency.count());
+        if (!busyControl) manager.updateAll();  // takes up the latch like the next tick would
+    }
+
+    stop = true;
+    if (control.joinable()) control.join();
+}
+BENCHMARK(BM_EmergencyStop_FastPath)->Arg(0)->Arg(1)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+// Previous design for comparison: a queued command only reaches the pump on the next
+// control tick. MANUAL_OFF still takes that path, the loop ticks every range(0) ms and the
+// message arrives just after a tick (worst case).
+static void BM_PumpOff_QueuedCommand(benchmark::State& state)
+{
+    spdlog::set_level(spdlog::level::off);
+    const auto tickPeriod = std::chrono::milliseconds(state.range(0));
+    SimulatedHardware sensor;
+    TimedPump pump;
+    ZoneManager manager;
+    manager.addZone(IrrigationConfig::forLoam("Bench Zone"), &sensor, &pump);
+    const std::string topic = ZoneManager::commandTopic(0);
+
+    std::atomic<bool> stop{false};
+    std::thread control([&]() {
+        auto next = std::chrono::steady_clock::now();
+        while (!stop.load(std::memory_order_relaxed)) {
+            manager.updateAll();
+            next += tickPeriod;
+            std::this_thread::sleep_until(next);
+        }
+    });
+
+    for (auto _ : state) {
+        manager.handleMessage(topic, "MANUAL_ON");
+        while (!pump.isActive()) std::this_thread::yield();
+        pump.clear();
+
+        auto arrived = std::chrono::steady_clock::now();
+        manager.handleMessage(topic, "MANUAL_OFF");
+        while (pump.lastOff() == std::chrono::steady_clock::time_point{}) std::this_thread::yield();
+        std::chrono::duration<double> latency = pump.lastOff() - arrived;
+        state.SetIterationTime(latency.count());
+    }
+
+    stop = true;
+    control.join();
+}
+BENCHMARK(BM_PumpOff_QueuedCommand)->Arg(10)->Arg(100)->Iterations(20)->UseManualTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,42 @@
+// bench/bench_flight_recorder.cpp
+#include <benchmark/benchmark.h>
+#include "flight_recorder.hpp"
+#include <atomic>
+#include <thread>
+
+// Cost the control thread pays per tick
+static void BM_FlightRecorderRecord(benchmark::State& state)
+{
+    FlightRecorder recorder;
+    FlightRecord entry;
+    for (auto _ : state) {
+        ++entry.tick;
+        entry.moisture = static_cast<double>(entry.tick & 127);
+        recorder.record(entry);
+    }
+    benchmark::DoNotOptimize(recorder.recorded());
+}
+BENCHMARK(BM_FlightRecorderRecord);
+
+// Copying the whole ring for a dump, optionally while a writer keeps recording
+static void BM_FlightRecorderSnapshot(benchmark::State& state)
+{
+    FlightRecorder recorder;
+    FlightRecord entry;
+    for (std::size_t i = 0; i < recorder.capacity(); ++i) { ++entry.tick; recorder.record(entry); }
+
+    std::atomic<bool> stop{false};
+    std::thread writer;
+    if (state.range(0) != 0) {
+        writer = std::thread([&]() {
+            FlightRecord next = entry;
+            while (!stop.load(std::memory_order_relaxed)) { ++next.tick; recorder.record(next); }
+        });
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(recorder.snapshot());
+    }
+    stop = true;
+    if (writer.joinable()) writer.join();
+}
+BENCHMARK(BM_FlightRecorderSnapshot)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,59 @@
+// bench/bench_irrigation_logic.cpp
+#include <benchmark/benchmark.h>
+#include "irrigation_logic.hpp"
+#include <chrono>
+#include <random>
+#include <vector>
+
+// range(0) readings 100ms apart, slowly rising with some noise
+static std::vector<sensorReading> readingWindow(std::size_t size)
+{
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(0.0, 0.5);
+    std::vector<sensorReading> readings;
+    auto start = std::chrono::steady_clock::time_point{} + std::chrono::hours(1);
+    for (std::size_t i = 0; i < size; ++i) {
+        double moisture = 30.0 + 0.01 * static_cast<double>(i) + noise(rng);
+        readings.push_back({moisture, start + i * std::chrono::milliseconds(100), true});
+    }
+    return readings;
+}
+
+static void BM_LogicFilteredMoisture(benchmark::State& state)
+{
+    auto readings = readingWindow(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(IrrigarionLogic::getFilteredMoisture(readings));
+    }
+}
+BENCHMARK(BM_LogicFilteredMoisture)->Arg(5)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_LogicChangeRate(benchmark::State& state)
+{
+    auto readings = readingWindow(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(IrrigarionLogic::getMoistuerChangeRate(readings));
+    }
+}
+BENCHMARK(BM_LogicChangeRate)->Arg(5)->Arg(10)->Arg(100)->Arg(1000);
+
+// The scalar decisions, cycled through a spread of inputs so no branch is always taken
+static void BM_LogicDecisions(benchmark::State& state)
+{
+    auto readings = readingWindow(64);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        double moisture = readings[i % readings.size()].moisturePercent;
+        int step = static_cast<int>(i % 64);
+        benchmark::DoNotOptimize(IrrigarionLogic::isReadingValid(moisture));
+        benchmark::DoNotOptimize(IrrigarionLogic::shouldStartWatering(
+            moisture, 30.5, step % 5, std::chrono::minutes(step), 30));
+        benchmark::DoNotOptimize(IrrigarionLogic::shouldStopWatering(
+            moisture, 30.5, std::chrono::seconds(step), 40, step % 3 ? std::optional<double>(0.2 * step) : std::nullopt));
+        benchmark::DoNotOptimize(IrrigarionLogic::shouldResumeMonitoring(std::chrono::minutes(step), 15));
+        benchmark::DoNotOptimize(IrrigarionLogic::canRecoverFromError(
+            step % 4, std::chrono::seconds(step * 10), 300, step % 2 == 0));
+        ++i;
+    }
+}
+BENCHMARK(BM_LogicDecisions);
@@ -0,0 +1,32 @@
+// bench/bench_moisture_filter.cpp
+#include <benchmark/benchmark.h>
+#include "moisture_filter.hpp"
+#include <random>
+#include <vector>
+
+// Cost of one add() per filter kind, the window size should not matter
+static void BM_MoistureFilterAdd(benchmark::State& state)
+{
+    auto kind = static_cast<FilterKind>(state.range(0));
+    auto window = static_cast<std::size_t>(state.range(1));
+    MoistureFilter filter(kind, window);
+
+    std::default_random_engine rng(42);
+    std::normal_distribution<double> noise(45.0, 2.0);
+    std::vector<double> input(4096);
+    for (auto& value : input) value = noise(rng);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(filter.add(input[i]));
+        i = (i + 1) & (input.size() - 1);
+    }
+    state.SetLabel(MoistureFilter::kindToString(kind));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MoistureFilterAdd)
+    ->ArgsProduct({
+        {static_cast<int>(FilterKind::MOVING_AVERAGE), static_cast<int>(FilterKind::EXPONENTIAL),
+         static_cast<int>(FilterKind::MEDIAN), static_cast<int>(FilterKind::HAMPEL)},
+        {5, 100, 5000}
+    });
@@ -0,0 +1,93 @@
+// bench/bench_simulation.cpp
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+#include "simulated_hardware.hpp"
+#include "zone_manager.hpp"
+#include "mqtt_handler.hpp"
+#include "clock.hpp"
+#include <memory>
+#include <vector>
+
+// One physics step of the simulator (100ms of virtual time)
+static void BM_SimulatedHardwareUpdate(benchmark::State& state)
+{
+    spdlog::set_level(spdlog::level::off);
+    VirtualClock clock;
+    SimulatedHardware sim(&clock);
+    sim.setScenario(SimulatedHardware::Scenario::DRY);
+    sim.activate();
+
+    for (auto _ : state) {
+        clock.advance(std::chrono::milliseconds(100));
+        sim.update();
+    }
+    benchmark::DoNotOptimize(sim.getMoisture());
+}
+BENCHMARK(BM_SimulatedHardwareUpdate);
+
+// Batched sensor read the control tick does
+static void BM_SimulatedHardwareReadAll(benchmark::State& state)
+{
+    spdlog::set_level(spdlog::level::off);
+    VirtualClock clock;
+    SimulatedHardware sim(&clock);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sim.readAll());
+    }
+}
+BENCHMARK(BM_SimulatedHardwareReadAll);
+
+class StatusSite {
+public:
+    explicit StatusSite(std::size_t zoneCount) : manager(&clock) {
+        spdlog::set_level(spdlog::level::off);
+        for (std::size_t i = 0; i < zoneCount; ++i) {
+            sims.push_back(std::make_unique<SimulatedHardware>(&clock));
+            manager.addZone(IrrigationConfig::forLoam("Zone " + std::to_string(i)), sims.back().get(), sims.back().get());
+        }
+        manager.updateAll();  // status comes from the last tick
+    }
+
+    VirtualClock clock;
+    std::vector<std::unique_ptr<SimulatedHardware>> sims;
+    ZoneManager manager;
+};
+
+// Status JSON of a single zone
+static void BM_StatusJson(benchmark::State& state)
+{
+    StatusSite site(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(site.manager.statusJson(0));
+    }
+}
+BENCHMARK(BM_StatusJson);
+
+// Every zone's status handed to a publish callback that only counts bytes
+static void BM_PublishStatusAllZones(benchmark::State& state)
+{
+    StatusSite site(static_cast<std::size_t>(state.range(0)));
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        site.manager.publishStatus([&bytes](const std::string& topic, const std::string& payload) {
+            bytes += topic.size() + payload.size();
+        });
+    }
+    benchmark::DoNotOptimize(bytes);
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_PublishStatusAllZones)->Arg(1)->Arg(10)->Arg(100);
+
+// MqttHandler::publish on a client that never connected: message setup and the client
+// library call, which rejects the message without any network I/O
+static void BM_MqttPublishDisconnected(benchmark::State& state)
+{
+    spdlog::set_level(spdlog::level::off);
+    MqttHandler mqtt("tcp://127.0.0.1:1", "bench_publisher");
+    StatusSite site(1);
+    std::string payload = site.manager.statusJson(0);
+    for (auto _ : state) {
+        mqtt.publish("irrigation/zones/0/status", payload);
+    }
+}
+BENCHMARK(BM_MqttPublishDisconnected);
@@ -0,0 +1,108 @@
+// bench/bench_state_dispatch.cpp
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+#include "state_machine.hpp"
+#include "simulated_hardware.hpp"
+#include "clock.hpp"
+#include <array>
+#include <map>
+#include <vector>
+
+// Sequence of states a simulated zone goes through, one entry per tick
+static const std::vector<SystemState>& simulatorStateTrace()
+{
+    static const std::vector<SystemState> trace = []() {
+        spdlog::set_level(spdlog::level::off);
+        VirtualClock clock;
+        SimulatedHardware sim(&clock);
+        auto config = IrrigationConfig::forSandy("Trace");
+        config.waitMinutes = 1;
+        config.minWateringIntervalMinutes = 1;
+        StateMachine machine(&sim, &sim, config, &clock);
+        sim.setScenario(SimulatedHardware::Scenario::DRY);
+        machine.sendCommnd(Command::START_AUTO);
+
+        std::vector<SystemState> states;
+        for (int tick = 0; tick < 100000; ++tick) {
+            clock.advance(StateMachine::TICK_PERIOD);
+            sim.update();
+            machine.update();
+            states.push_back(machine.getCurrentState());
+        }
+        return states;
+    }();
+    return trace;
+}
+
+// Minimal stand-in with the same handler shape as StateMachine, so only dispatch is measured
+struct DispatchTarget {
+    int work = 0;
+    SystemState idle() { benchmark::DoNotOptimize(++work); return SystemState::IDLE; }
+    SystemState monitoring() { benchmark::DoNotOptimize(++work); return SystemState::MONITORING; }
+    SystemState watering() { benchmark::DoNotOptimize(++work); return SystemState::WATERING; }
+    SystemState waiting() { benchmark::DoNotOptimize(++work); return SystemState::WAITING; }
+    SystemState error() { benchmark::DoNotOptimize(++work); return SystemState::ERROR; }
+    SystemState manual() { benchmark::DoNotOptimize(++work); return SystemState::MANUAL; }
+};
+using TargetHandler = SystemState (DispatchTarget::*)();
+
+// Previous dispatch: std::map lookup through operator[] on every tick
+static void BM_MapDispatch(benchmark::State& state)
+{
+    const auto& trace = simulatorStateTrace();
+    std::map<SystemState, TargetHandler> handlers;
+    handlers[SystemState::IDLE] = &DispatchTarget::idle;
+    handlers[SystemState::MONITORING] = &DispatchTarget::monitoring;
+    handlers[SystemState::WATERING] = &DispatchTarget::watering;
+    handlers[SystemState::WAITING] = &DispatchTarget::waiting;
+    handlers[SystemState::ERROR] = &DispatchTarget::error;
+    handlers[SystemState::MANUAL] = &DispatchTarget::manual;
+    DispatchTarget target;
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto handler = handlers[trace[i]];
+        benchmark::DoNotOptimize((target.*handler)());
+        if (++i == trace.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MapDispatch);
+
+// Current dispatch: constexpr table indexed by the enum
+static void BM_TableDispatch(benchmark::State& state)
+{
+    const auto& trace = simulatorStateTrace();
+    static constexpr std::array<TargetHandler, STATE_COUNT> handlers = {
+        &DispatchTarget::idle, &DispatchTarget::monitoring, &DispatchTarget::watering,
+        &DispatchTarget::waiting, &DispatchTarget::error, &DispatchTarget::manual
+    };
+    DispatchTarget target;
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto handler = handlers[static_cast<std::size_t>(trace[i])];
+        benchmark::DoNotOptimize((target.*handler)());
+        if (++i == trace.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TableDispatch);
+
+// Whole tick for context: dispatch share of a simulated StateMachine::update()
+static void BM_SimulatedTick(benchmark::State& state)
+{
+    spdlog::set_level(spdlog::level::off);
+    VirtualClock clock;
+    SimulatedHardware sim(&clock);
+    StateMachine machine(&sim, &sim, IrrigationConfig::forSandy("Bench"), &clock);
+    machine.sendCommnd(Command::START_AUTO);
+
+    for (auto _ : state) {
+        clock.advance(StateMachine::TICK_PERIOD);
+        sim.update();
+        machine.update();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SimulatedTick);
@@ -0,0 +1,119 @@
+// bench/bench_state_machine.cpp
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+#include "state_machine.hpp"
+#include "clock.hpp"
+
+// Sensor with fixed readings, so a zone can be parked in any state
+class FixedSensor : public ISensorInterface {
+public:
+    bool initialize() override { return true; }
+    double getMoisture() override { return moisture; }
+    double getTemp() override { return 22.0; }
+    double getHumid() override { return 55.0; }
+    bool isRainDetected() override { return false; }
+    bool isHealthy() override { return true; }
+    SensorFrame readAll() override { return readEachChannel(std::chrono::steady_clock::time_point{}); }
+
+    double moisture = 45.0;
+};
+
+class FixedPump : public IPumpInterface {
+public:
+    bool initialize() override { return true; }
+    void activate() override { running = true; }
+    void deactivate() override { running = false; }
+    bool isActive() override { return running; }
+
+    bool running = false;
+};
+
+// One zone driven into `target` and then held there: the clock stops, so no timer
+// based transition fires and every update() runs the same handler.
+class ParkedZone {
+public:
+    explicit ParkedZone(SystemState target)
+        : machine(&sensor, &pump, config(), &clock)
+    {
+        spdlog::set_level(spdlog::level::off);
+        switch (target) {
+            case SystemState::IDLE:
+                break;
+            case SystemState::MONITORING:
+                start();
+                break;
+            case SystemState::WATERING:
+                sensor.moisture = 10.0;
+                start();
+                runUntil(SystemState::WATERING);
+                break;
+            case SystemState::WAITING:
+                sensor.moisture = 10.0;
+                start();
+                runUntil(SystemState::WATERING);
+                sensor.moisture = 90.0;
+                runUntil(SystemState::WAITING);
+                break;
+            case SystemState::ERROR:
+                machine.sendCommnd(Command::EMERGENCY_STOP);
+                machine.update();
+                break;
+            case SystemState::MANUAL:
+                machine.sendCommnd(Command::ENABLE_MANUAL);
+                machine.update();
+                break;
+        }
+    }
+
+    static IrrigationConfig config() {
+        IrrigationConfig config = IrrigationConfig::forLoam("Bench Zone");
+        config.minWateringIntervalMinutes = 0;
+        return config;
+    }
+
+    void start() {
+        machine.sendCommnd(Command::START_AUTO);
+        machine.update();
+    }
+
+    void runUntil(SystemState state) {
+        for (int i = 0; i < 1000 && machine.getCurrentState() != state; ++i) {
+            clock.advance(StateMachine::TICK_PERIOD);
+            machine.update();
+        }
+    }
+
+    VirtualClock clock;
+    FixedSensor sensor;
+    FixedPump pump;
+    StateMachine machine;
+};
+
+// StateMachine::update() for a zone resting in each state
+static void BM_StateMachineUpdate(benchmark::State& state)
+{
+    auto target = static_cast<SystemState>(state.range(0));
+    ParkedZone zone(target);
+    if (zone.machine.getCurrentState() != target) {
+        state.SkipWithError("zone did not reach the requested state");
+        return;
+    }
+
+    for (auto _ : state) {
+        zone.machine.update();
+    }
+    state.SetLabel(StateMachine::stateToString(target));
+    if (zone.machine.getCurrentState() != target)
+        state.SkipWithError("zone left the requested state");
+}
+BENCHMARK(BM_StateMachineUpdate)->DenseRange(0, static_cast<int>(STATE_COUNT) - 1);
+
+// Status snapshot read by the publisher thread
+static void BM_StateMachineGetStatus(benchmark::State& state)
+{
+    ParkedZone zone(SystemState::MONITORING);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(zone.machine.getStatus());
+    }
+}
+BENCHMARK(BM_StateMachineGetStatus);
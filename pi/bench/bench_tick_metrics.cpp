@@ -0,0 +1,57 @@
+// bench/bench_tick_metrics.cpp
+#include <benchmark/benchmark.h>
+#include "latency_histogram.hpp"
+#include "tick_metrics.hpp"
+#include <chrono>
+#include <random>
+#include <vector>
+
+// Samples spread over ~100ns..10ms so every bucket path is exercised
+static std::vector<std::chrono::nanoseconds> latencySamples()
+{
+    std::mt19937 rng(11);
+    std::lognormal_distribution<double> spread(8.0, 2.0);
+    std::vector<std::chrono::nanoseconds> samples(4096);
+    for (auto& sample : samples) sample = std::chrono::nanoseconds(static_cast<int64_t>(spread(rng)));
+    return samples;
+}
+
+// Cost of one sample, the figure that matters on the control thread
+static void BM_LatencyHistogramRecord(benchmark::State& state)
+{
+    auto samples = latencySamples();
+    LatencyHistogram histogram;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        histogram.record(samples[i++ & (samples.size() - 1)]);
+    }
+    benchmark::DoNotOptimize(histogram.count());
+}
+BENCHMARK(BM_LatencyHistogramRecord);
+
+// One zone tick: the state total plus every phase
+static void BM_TickMetricsRecord(benchmark::State& state)
+{
+    auto samples = latencySamples();
+    auto metrics = std::make_unique<TickMetrics>();
+    TickTiming timing;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        timing.state = static_cast<SystemState>(i % STATE_COUNT);
+        for (auto& phase : timing.phases) phase = samples[i++ & (samples.size() - 1)];
+        timing.total = timing.phases[0] + timing.phases[1];
+        metrics->record(timing);
+    }
+    benchmark::DoNotOptimize(metrics->total(SystemState::IDLE).count());
+}
+BENCHMARK(BM_TickMetricsRecord);
+
+static void BM_LatencyHistogramP99(benchmark::State& state)
+{
+    LatencyHistogram histogram;
+    for (auto sample : latencySamples()) histogram.record(sample);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(histogram.percentile(99));
+    }
+}
+BENCHMARK(BM_LatencyHistogramP99);
@@ -0,0 +1,76 @@
+// bench/bench_trace_replay.cpp
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+#include "trace.hpp"
+#include "trace_replay.hpp"
+#include "simulated_hardware.hpp"
+#include "clock.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+// A simulated day of one dry sandy zone, recorded once and shared by the benchmarks below
+static const std::vector<std::uint8_t>& dayTrace()
+{
+    static const std::vector<std::uint8_t> bytes = []() {
+        spdlog::set_level(spdlog::level::off);
+        std::string path = (std::filesystem::temp_directory_path() / "bench_day.irt").string();
+        {
+            VirtualClock clock;
+            SimulatedHardware hardware(&clock);
+            hardware.setScenario(SimulatedHardware::Scenario::DRY);
+            TraceWriter writer(path);
+            StateMachine machine(&hardware, &hardware, IrrigationConfig::forSandy("Bench Zone"), &clock);
+            machine.attachTrace(&writer);
+            machine.sendCommnd(Command::START_AUTO);
+            while (clock.now().time_since_epoch() < std::chrono::hours(24)) {
+                hardware.update();
+                machine.update();
+                clock.set(machine.nextDeadline());
+            }
+        }
+        std::vector<std::uint8_t> trace;
+        TraceReader::load(path, trace);
+        std::remove(path.c_str());
+        return trace;
+    }();
+    return bytes;
+}
+
+// The whole decision path on recorded input, items are replayed ticks
+static void BM_TraceReplayDay(benchmark::State& state)
+{
+    const auto& trace = dayTrace();
+    std::uint64_t ticks = 0;
+    for (auto _ : state) {
+        ReplayResult result = TraceReplay::run(trace);
+        ticks += result.ticks;
+        benchmark::DoNotOptimize(result.divergences);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(ticks));
+    state.counters["trace_kib"] = static_cast<double>(trace.size()) / 1024.0;
+}
+BENCHMARK(BM_TraceReplayDay)->Unit(benchmark::kMillisecond);
+
+// What recording adds to one live WATERING style tick: the tick, one frame and the decision
+static void BM_TraceWriterTick(benchmark::State& state)
+{
+    std::string path = (std::filesystem::temp_directory_path() / "bench_writer.irt").string();
+    TraceWriter writer(path);
+    writer.begin(std::chrono::steady_clock::time_point{}, IrrigationConfig{});
+    SensorFrame frame;
+    frame.healthy = true;
+    auto now = std::chrono::steady_clock::time_point{};
+    for (auto _ : state) {
+        now += std::chrono::milliseconds(100);
+        frame.moisture += 0.01;
+        frame.timeStamp = now;
+        writer.tick(now);
+        writer.frame(frame, true);
+        writer.decision(SystemState::WATERING, 0);
+    }
+    writer.close();
+    state.counters["dropped"] = static_cast<double>(writer.droppedEvents());
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_TraceWriterTick);
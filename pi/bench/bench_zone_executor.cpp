@@ -0,0 +1,69 @@
+// bench/bench_zone_executor.cpp
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+#include "zone_manager.hpp"
+#include "zone_executor.hpp"
+#include "simulated_hardware.hpp"
+#include "clock.hpp"
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Sharded StateMachine::update across 1..N threads.
+// Args: zones, threads, zones per shared bus (0 = every zone has its own bus)
+static void BM_ParallelZoneUpdate(benchmark::State& state)
+{
+    auto zones = static_cast<std::size_t>(state.range(0));
+    auto threads = static_cast<std::size_t>(state.range(1));
+    auto zonesPerBus = static_cast<std::size_t>(state.range(2));
+
+    spdlog::set_level(spdlog::level::off);
+    VirtualClock clock;
+    std::vector<std::unique_ptr<SimulatedHardware>> sims;
+    ZoneManager manager(&clock);
+    for (std::size_t i = 0; i < zones; ++i) {
+        sims.push_back(std::make_unique<SimulatedHardware>(&clock));
+        std::optional<int> bus;
+        if (zonesPerBus > 0) bus = static_cast<int>(i / zonesPerBus);
+        manager.addZone(IrrigationConfig::forLoam("Zone " + std::to_string(i)), sims.back().get(), sims.back().get(), bus);
+    }
+    ZoneExecutor executor(threads);
+    manager.setExecutor(&executor);
+    manager.sendCommandToAll(Command::START_AUTO);
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        clock.advance(StateMachine::TICK_PERIOD);
+        manager.updateAll();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double perTick = elapsed.count() / static_cast<double>(state.iterations());
+
+    // Scaling efficiency against the single thread run of the same workload
+    static std::map<std::pair<std::size_t, std::size_t>, double> singleThreadTick;
+    auto key = std::make_pair(zones, zonesPerBus);
+    if (threads == 1) singleThreadTick[key] = perTick;
+    if (singleThreadTick.count(key)) {
+        double speedup = singleThreadTick[key] / perTick;
+        state.counters["speedup"] = speedup;
+        state.counters["efficiency"] = speedup / static_cast<double>(threads);
+    }
+    state.counters["threads"] = static_cast<double>(threads);
+    state.counters["steals"] = static_cast<double>(executor.stealCount());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * zones));
+}
+
+static void parallelZoneArgs(benchmark::internal::Benchmark* bench)
+{
+    int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int zonesPerBus : {0, 16}) {
+        for (int zones : {1000, 10000}) {
+            for (int threads = 1; threads <= maxThreads; threads *= 2)
+                bench->Args({zones, threads, zonesPerBus});
+            if ((maxThreads & (maxThreads - 1)) != 0)
+                bench->Args({zones, maxThreads, zonesPerBus});
+        }
+    }
+}
+BENCHMARK(BM_ParallelZoneUpdate)->Apply(parallelZoneArgs)->Unit(benchmark::kMicrosecond)->UseRealTime();
@@ -0,0 +1,76 @@
+// bench/bench_zone_manager.cpp
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+#include "zone_manager.hpp"
+#include "simulated_hardware.hpp"
+#include "clock.hpp"
+#include <memory>
+#include <vector>
+
+// N simulated zones cycling through the soil presets, sharing one virtual clock
+class SimulatedSite {
+public:
+    explicit SimulatedSite(std::size_t zoneCount) : manager(&clock) {
+        spdlog::set_level(spdlog::level::off);
+        for (std::size_t i = 0; i < zoneCount; ++i) {
+            auto sim = std::make_unique<SimulatedHardware>(&clock);
+            std::string name = "Zone " + std::to_string(i);
+            IrrigationConfig config;
+            switch (i % 4) {
+                case 0: config = IrrigationConfig::forLoam(name); break;
+                case 1: config = IrrigationConfig::forClay(name); break;
+                case 2: config = IrrigationConfig::forSandy(name); break;
+                default: config = IrrigationConfig::forPeat(name); break;
+            }
+            manager.addZone(config, sim.get(), sim.get());
+            sims.push_back(std::move(sim));
+        }
+        manager.sendCommandToAll(Command::START_AUTO);
+    }
+
+    void advanceSimulation() {
+        for (auto& sim : sims) sim->update();
+    }
+
+    VirtualClock clock;
+    std::vector<std::unique_ptr<SimulatedHardware>> sims;
+    ZoneManager manager;
+};
+
+static void setPerZoneCounters(benchmark::State& state, std::size_t zones)
+{
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * zones));
+    state.counters["zones"] = static_cast<double>(zones);
+    state.counters["time_per_zone"] = benchmark::Counter(
+        static_cast<double>(zones),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+// Control cost only: one tick of every zone's StateMachine
+static void BM_ZoneManagerUpdate(benchmark::State& state)
+{
+    auto zones = static_cast<std::size_t>(state.range(0));
+    SimulatedSite site(zones);
+
+    for (auto _ : state) {
+        site.clock.advance(StateMachine::TICK_PERIOD);
+        site.manager.updateAll();
+    }
+    setPerZoneCounters(state, zones);
+}
+BENCHMARK(BM_ZoneManagerUpdate)->Arg(10)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+// Full simulated tick: physics plus control for every zone
+static void BM_ZoneManagerUpdateWithSimulation(benchmark::State& state)
+{
+    auto zones = static_cast<std::size_t>(state.range(0));
+    SimulatedSite site(zones);
+
+    for (auto _ : state) {
+        site.clock.advance(StateMachine::TICK_PERIOD);
+        site.advanceSimulation();
+        site.manager.updateAll();
+    }
+    setPerZoneCounters(state, zones);
+}
+BENCHMARK(BM_ZoneManagerUpdateWithSimulation)->Arg(10)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,93 @@
+#ifndef ASYNC_SENSOR_READER_HPP
+#define ASYNC_SENSOR_READER_HPP
+
+#include "i_sensor_interface.hpp"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+enum class SensorChannel
+{
+    MOISTURE,
+    TEMPERATURE,
+    HUMIDITY
+};
+constexpr std::size_t SENSOR_CHANNEL_COUNT = 3;
+
+// Decorator that runs each slow analog conversion on its own worker and waits for it only
+// up to a per-channel deadline. A late channel reports its last good value together with
+// the value's age, the conversion keeps running and its result is used by a later read with
+// the age it has by then; the next conversion starts as soon as such a result is taken.
+// Rain and health are digital and read inline. The wrapped sensor must allow its channels
+// to be read from different threads.
+class AsyncSensorReader : public ISensorInterface
+{
+    public:
+        struct Deadlines
+        {
+            std::chrono::microseconds moisture{std::chrono::milliseconds(10)};
+            std::chrono::microseconds temperature{std::chrono::milliseconds(10)};
+            std::chrono::microseconds humidity{std::chrono::milliseconds(10)};
+        };
+
+        AsyncSensorReader(ISensorInterface* sensor, Deadlines deadlines);
+        explicit AsyncSensorReader(ISensorInterface* sensor);
+        ~AsyncSensorReader();
+
+        AsyncSensorReader(const AsyncSensorReader&) = delete;
+        AsyncSensorReader& operator=(const AsyncSensorReader&) = delete;
+
+        bool initialize() override;
+        double getMoisture() override;
+        double getTemp() override;
+        double getHumid() override;
+        bool isRainDetected() override;
+        bool isHealthy() override;
+        SensorFrame readAll() override;//waits at most for the longest channel deadline
+
+        uint64_t lateCount(SensorChannel channel) const;//reads that fell back to the last good value
+
+    private:
+        struct Sample
+        {
+            double value = 0.0;
+            bool valid = false;//false until the first conversion finished
+            std::chrono::microseconds age{0};//0 when converted for this read, never 0 otherwise
+        };
+
+        struct Channel
+        {
+            std::chrono::microseconds deadline{0};
+            std::thread worker;
+            mutable std::mutex mutex;
+            std::condition_variable signal;
+            bool requested = false;
+            bool busy = false;
+            bool hasResult = false;//finished conversion not yet handed out
+            bool hasGood = false;
+            bool stopping = false;
+            double result = 0.0;
+            double lastGood = 0.0;
+            std::chrono::steady_clock::time_point resultStarted{};//when the result's conversion began
+            std::chrono::steady_clock::time_point resultTime{};
+            std::chrono::steady_clock::time_point lastGoodTime{};
+            uint64_t late = 0;
+        };
+
+        void request(Channel& channel);//starts a conversion unless one is running
+        // a result counts as converted for the read when its conversion began at readStart or later
+        Sample collect(Channel& channel, std::chrono::steady_clock::time_point readStart,
+                       std::chrono::steady_clock::time_point deadline);
+        Sample readChannel(SensorChannel channel);
+        void workerLoop(SensorChannel channel);
+        double convert(SensorChannel channel);
+
+        ISensorInterface* sensor;
+        std::chrono::steady_clock::time_point created;//age of a channel that never delivered
+        std::array<Channel, SENSOR_CHANNEL_COUNT> channels;
+};
+
+#endif // ASYNC_SENSOR_READER_HPP
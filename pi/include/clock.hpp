@@ -0,0 +1,46 @@
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+#include "i_clock_interface.hpp"
+#include <atomic>
+
+// Real monotonic clock
+class SteadyClock : public IClockInterface {
+public:
+    std::chrono::steady_clock::time_point now() override {
+        return std::chrono::steady_clock::now();
+    }
+
+    // Shared instance used when no clock is injected
+    static SteadyClock& instance() {
+        static SteadyClock clock;
+        return clock;
+    }
+};
+
+// Manually advanced clock, time only moves when advance()/set() is called
+class VirtualClock : public IClockInterface {
+public:
+    explicit VirtualClock(std::chrono::steady_clock::time_point start = {})
+        : ticks(start.time_since_epoch().count()) {}
+
+    std::chrono::steady_clock::time_point now() override {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(ticks.load(std::memory_order_acquire)));
+    }
+
+    template <typename Rep, typename Period>
+    void advance(std::chrono::duration<Rep, Period> step) {
+        ticks.fetch_add(std::chrono::duration_cast<std::chrono::steady_clock::duration>(step).count(),
+                        std::memory_order_acq_rel);
+    }
+
+    void set(std::chrono::steady_clock::time_point time) {
+        ticks.store(time.time_since_epoch().count(), std::memory_order_release);
+    }
+
+private:
+    std::atomic<std::chrono::steady_clock::rep> ticks;
+};
+
+#endif // CLOCK_HPP
@@ -0,0 +1,99 @@
+#ifndef CONFIG_STORE_HPP
+#define CONFIG_STORE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Immutable versioned configuration snapshots, RCU style.
+// The owning control thread reads with pin(): one atomic load and one atomic store,
+// no lock and no allocation. Writers build a new snapshot and swap it in atomically.
+// Old snapshots are freed by a later writer once the reader has announced (through the
+// version it last pinned) that it moved past them, so pin() must only be called from
+// one thread at a time. Any thread may take a copy with get().
+template <typename T>
+class ConfigStore
+{
+    public:
+        struct Snapshot
+        {
+            T value;
+            std::uint64_t version;
+        };
+
+        explicit ConfigStore(const T& initial)
+        {
+            current.store(new Snapshot{initial, 1}, std::memory_order_release);
+        }
+
+        ~ConfigStore()
+        {
+            delete current.load(std::memory_order_relaxed);
+            for (Snapshot* snapshot : retired) delete snapshot;
+        }
+
+        ConfigStore(const ConfigStore&) = delete;
+        ConfigStore& operator=(const ConfigStore&) = delete;
+
+        // Reader side, the returned snapshot stays valid until the next pin()
+        const Snapshot& pin()
+        {
+            const Snapshot* snapshot = current.load(std::memory_order_acquire);
+            // every older snapshot is no longer referenced by this reader
+            pinnedVersion.store(snapshot->version, std::memory_order_release);
+            return *snapshot;
+        }
+
+        // Copy of the latest snapshot, any thread
+        T get() const
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            return current.load(std::memory_order_relaxed)->value;
+        }
+
+        // Publishes a new snapshot, returns its version
+        std::uint64_t update(T value)
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            Snapshot* previous = current.load(std::memory_order_relaxed);
+            auto* next = new Snapshot{std::move(value), previous->version + 1};
+            current.store(next, std::memory_order_release);
+            retired.push_back(previous);
+            reclaim();
+            return next->version;
+        }
+
+        std::uint64_t version() const
+        {
+            return current.load(std::memory_order_acquire)->version;
+        }
+
+        std::size_t retiredCount() const
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            return retired.size();
+        }
+
+    private:
+        // writerMutex held
+        void reclaim()
+        {
+            std::uint64_t pinned = pinnedVersion.load(std::memory_order_acquire);
+            std::erase_if(retired, [pinned](Snapshot* snapshot) {
+                if (snapshot->version >= pinned) return false;
+                delete snapshot;
+                return true;
+            });
+        }
+
+        std::atomic<Snapshot*> current{nullptr};
+        std::atomic<std::uint64_t> pinnedVersion{0};
+
+        mutable std::mutex writerMutex;
+        std::vector<Snapshot*> retired;
+};
+
+#endif // CONFIG_STORE_HPP
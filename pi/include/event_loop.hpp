@@ -0,0 +1,52 @@
+#ifndef EVENT_LOOP_HPP
+#define EVENT_LOOP_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Deadline driven event loop (Linux timerfd + eventfd + epoll).
+// The loop sleeps until a timer expires or wake() is called, nothing polls.
+class EventLoop
+{
+    public:
+        using Callback = std::function<void()>;
+        using TimerId = std::size_t;
+
+        EventLoop();
+        ~EventLoop();
+
+        EventLoop(const EventLoop&) = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+
+        TimerId addTimer(Callback callback);//timer starts disarmed
+        void armAt(TimerId timer, std::chrono::steady_clock::time_point deadline);//one shot
+        void armEvery(TimerId timer, std::chrono::milliseconds period);//periodic
+        void disarm(TimerId timer);
+
+        void setWakeHandler(Callback callback);
+        void wake();//thread safe, runs the wake handler on the loop thread
+
+        void run();//blocks until stop()
+        void stop();//thread safe
+
+        uint64_t wakeupCount() const;
+
+    private:
+        struct Timer {
+            int fd;
+            Callback callback;
+        };
+
+        int epollFd = -1;
+        int wakeFd = -1;
+        std::vector<Timer> timers;
+        Callback wakeHandler;
+
+        std::atomic<bool> running{false};
+        std::atomic<uint64_t> wakeups{0};
+};
+
+#endif // EVENT_LOOP_HPP
@@ -0,0 +1,86 @@
+#ifndef FLIGHT_RECORDER_HPP
+#define FLIGHT_RECORDER_HPP
+
+#include "seqlock.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Inputs and outputs of one update(), fixed layout so a dump can be decoded offline.
+// States are stored as the SystemState value.
+struct FlightRecord
+{
+    std::uint64_t tick = 0;
+    std::int64_t timeNs = 0;            // clock time of the tick
+    double moisture = 0.0;              // raw reading, see SENSOR_READ
+    double filteredMoisture = 0.0;
+    double changeRate = 0.0;            // watering trend in %/min, NaN without a fit
+    std::uint32_t configVersion = 0;
+    std::uint16_t readFailures = 0;     // consecutiveReadFailures after the tick
+    std::uint16_t lowReadings = 0;      // consecutiveLowReadings after the tick
+    std::uint8_t state = 0;             // state whose handler ran
+    std::uint8_t nextState = 0;         // state after the tick
+    std::uint8_t flags = 0;
+    std::uint8_t commands = 0;          // commands drained this tick
+
+    static constexpr std::uint8_t SENSOR_READ = 1 << 0;    // sensors were read this tick
+    static constexpr std::uint8_t FRESH_FRAME = 1 << 1;    // and delivered a new sample
+    static constexpr std::uint8_t PUMP_STARTED = 1 << 2;
+    static constexpr std::uint8_t PUMP_STOPPED = 1 << 3;
+    static constexpr std::uint8_t PUMP_RUNNING = 1 << 4;   // after the tick
+    static constexpr std::uint8_t EMERGENCY_STOP = 1 << 5; // e-stop latch taken up this tick
+    static constexpr std::uint8_t PUMP_BITS = PUMP_STARTED | PUMP_STOPPED | PUMP_RUNNING;
+};
+static_assert(sizeof(FlightRecord) == 56, "FlightRecord is part of the dump format");
+
+enum class FlightDumpReason : std::uint32_t
+{
+    ERROR = 1,      // the zone entered ERROR
+    REQUESTED = 2   // asked for over MQTT
+};
+
+// Start of a dump file, followed by `count` records oldest first (host byte order)
+struct FlightDumpHeader
+{
+    char magic[4] = {'I', 'R', 'F', 'R'};
+    std::uint16_t version = 1;
+    std::uint16_t recordSize = sizeof(FlightRecord);
+    std::uint32_t count = 0;
+    FlightDumpReason reason = FlightDumpReason::REQUESTED;
+    std::uint64_t recorded = 0;         // records written since start, older ones were overwritten
+    char zone[40] = {};                 // zone name, zero terminated
+};
+static_assert(sizeof(FlightDumpHeader) == 64, "FlightDumpHeader is part of the dump format");
+
+// Always-on ring of the latest update() records of one zone.
+// record() is called by the control thread only: one sequence-locked slot write, no lock
+// and no allocation. snapshot() and dump() may run on any thread at the same time; a slot
+// overwritten while it is being copied is left out instead of blocking the writer.
+class FlightRecorder
+{
+    public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 128;//~13s of WATERING ticks, 8 KiB
+
+        explicit FlightRecorder(std::size_t capacity = DEFAULT_CAPACITY);//rounded up to a power of two
+
+        void record(const FlightRecord& entry);
+
+        std::vector<FlightRecord> snapshot() const;//oldest first
+        bool latest(FlightRecord& entry) const;//newest record, false before the first one
+        // writes the current ring to path, false when the file cannot be written
+        bool dump(const std::string& path, const std::string& zoneName, FlightDumpReason reason) const;
+        // reads a dump back, false on a missing file or a foreign format
+        static bool load(const std::string& path, FlightDumpHeader& header, std::vector<FlightRecord>& records);
+
+        std::uint64_t recorded() const;
+        std::size_t capacity() const;
+
+    private:
+        std::vector<SeqLock<FlightRecord>> slots;
+        std::size_t mask;
+        std::atomic<std::uint64_t> written{0};
+};
+
+#endif // FLIGHT_RECORDER_HPP
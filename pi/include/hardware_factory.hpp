@@ -17,11 +17,12 @@ struct HardwareBundle {
 
 class HardwareFactory {
 public:
-    static HardwareBundle createHardware(bool useSimulator) {
+    // clock only drives the simulator physics, nullptr means the real steady clock
+    static HardwareBundle createHardware(bool useSimulator, IClockInterface* clock = nullptr) {
         HardwareBundle bundle;
         
         if (useSimulator) {
-            auto sim = std::make_shared<SimulatedHardware>();
+            auto sim = std::make_shared<SimulatedHardware>(clock);
             bundle.hardwareInstance = sim;
             bundle.sensor = sim;
             bundle.pump = sim;
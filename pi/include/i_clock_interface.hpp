@@ -0,0 +1,15 @@
+#ifndef I_CLOCK_INTERFACE_HPP
+#define I_CLOCK_INTERFACE_HPP
+
+#include <chrono>
+
+// Source of "now" for everything that makes time based decisions.
+// Production code uses SteadyClock, tests and fast simulations use VirtualClock.
+class IClockInterface
+{
+    public:
+        virtual ~IClockInterface() = default;
+        virtual std::chrono::steady_clock::time_point now() = 0;
+};
+
+#endif
@@ -1,13 +1,17 @@
 #ifndef I_PUMP_INTERFACE_HPP
 #define I_PUMP_INTERFACE_HPP
 
+// activate() and isActive() are called from the control thread. deactivate() must be callable
+// from any thread at the same time (emergency stop from MQTT, the watchdog's stall cut-off),
+// and the three calls must be linearizable: once deactivate() returns, isActive() is false
+// until the next activate().
 class IPumpInterface {
 public:
     virtual ~IPumpInterface() = default;
     
     virtual bool initialize() = 0;
     virtual void activate() = 0;
-    virtual void deactivate() = 0;
+    virtual void deactivate() = 0;//any thread
     virtual bool isActive() = 0;
 };
 
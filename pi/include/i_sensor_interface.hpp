@@ -1,6 +1,35 @@
 #ifndef I_SENSOR_INTERFACE_HPP
 #define I_SENSOR_INTERFACE_HPP
 
+#include <chrono>
+
+// Every sensor channel from a single acquisition, with per-channel validity
+struct SensorFrame
+{
+    double moisture = 0.0;
+    double temperature = 0.0;
+    double humidity = 0.0;
+    bool rainDetected = false;
+    bool healthy = false;
+    bool moistureValid = false;     // within the sensor's physical range
+    bool temperatureValid = false;
+    bool humidityValid = false;
+    std::chrono::steady_clock::time_point timeStamp{};
+    // 0 when the value was converted for this frame, otherwise the age of a reused last good
+    // value (or how long the channel has gone without one)
+    std::chrono::microseconds moistureAge{0};
+    std::chrono::microseconds temperatureAge{0};
+    std::chrono::microseconds humidityAge{0};
+
+    // fills the validity flags from the channel values
+    void validate()
+    {
+        moistureValid = moisture >= -5.0 && moisture <= 105.0;
+        temperatureValid = temperature >= -40.0 && temperature <= 85.0;
+        humidityValid = humidity >= 0.0 && humidity <= 100.0;
+    }
+};
+
 class ISensorInterface
 {
     public:
@@ -11,6 +40,22 @@ class ISensorInterface
         virtual double getHumid() = 0;
         virtual bool isRainDetected() = 0;
         virtual bool isHealthy() = 0;
+        virtual SensorFrame readAll() = 0;//all channels in one transaction, once per tick
+
+    protected:
+        //frame from the single-channel getters, for drivers without a batched read
+        SensorFrame readEachChannel(std::chrono::steady_clock::time_point timeStamp)
+        {
+            SensorFrame frame;
+            frame.moisture = getMoisture();
+            frame.temperature = getTemp();
+            frame.humidity = getHumid();
+            frame.rainDetected = isRainDetected();
+            frame.healthy = isHealthy();
+            frame.timeStamp = timeStamp;
+            frame.validate();
+            return frame;
+        }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -3,7 +3,7 @@
 #include <string>
 #include <chrono>
 #include <optional>
-#include <deque>
+#include <span>
 
 struct sensorReading{
     double moisturePercent;
@@ -11,14 +11,13 @@ struct sensorReading{
     bool isValid;
 };
 
+//history is passed as a contiguous view, oldest reading first
 class IrrigarionLogic
 {
-    private:
-        std::deque<sensorReading> sensorReadings;
     public:
         static bool isReadingValid(double moisture);//checks validity of sensor reading
-        static double getFilteredMoisture(const std::deque<sensorReading>& readings);//gets average last 5 readings
-        static std::optional<double>getMoistuerChangeRate(const std::deque<sensorReading>& readings);//gets changerate of moisture
+        static double getFilteredMoisture(std::span<const sensorReading> readings);//gets average last 5 readings
+        static std::optional<double>getMoistuerChangeRate(std::span<const sensorReading> readings);//least-squares moisture trend in %/min
         //decisions
         static bool shouldStartWatering(double filteredMoisture,
         double threshold,
@@ -0,0 +1,112 @@
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Fixed size log-linear latency histogram in nanoseconds (HDR style).
+// Every power of two is split into SUB_BUCKETS linear steps, so a reported value is at most
+// 1/SUB_BUCKETS above the recorded one. record() never allocates, one thread at a time.
+class LatencyHistogram
+{
+    public:
+        static constexpr int SUB_BITS = 3;
+        static constexpr std::uint64_t SUB_BUCKETS = 1u << SUB_BITS;
+        static constexpr int MAX_BITS = 40;  // ~18 minutes, longer values land in the last bucket
+        static constexpr std::size_t BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_BUCKETS;
+
+        void record(std::chrono::nanoseconds value)
+        {
+            std::uint64_t ns = value.count() > 0 ? static_cast<std::uint64_t>(value.count()) : 0;
+            ++buckets[bucketFor(ns)];
+            if (total == 0 || ns < minimum) minimum = ns;
+            maximum = std::max(maximum, ns);
+            sum += ns;
+            ++total;
+        }
+
+        void merge(const LatencyHistogram& other)
+        {
+            if (other.total == 0) return;
+            for (std::size_t i = 0; i < BUCKETS; ++i) buckets[i] += other.buckets[i];
+            minimum = total == 0 ? other.minimum : std::min(minimum, other.minimum);
+            maximum = std::max(maximum, other.maximum);
+            sum += other.sum;
+            total += other.total;
+        }
+
+        void reset() { *this = LatencyHistogram{}; }
+
+        std::uint64_t count() const { return total; }
+        std::chrono::nanoseconds min() const { return std::chrono::nanoseconds(minimum); }
+        std::chrono::nanoseconds max() const { return std::chrono::nanoseconds(maximum); }
+        std::chrono::nanoseconds mean() const
+        {
+            return std::chrono::nanoseconds(total ? sum / total : 0);
+        }
+
+        // Upper edge of the bucket holding the p-th percentile (0..100), never above max()
+        std::chrono::nanoseconds percentile(double p) const
+        {
+            if (total == 0) return std::chrono::nanoseconds(0);
+            auto rank = static_cast<std::uint64_t>(std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(total) + 0.5);
+            rank = std::clamp<std::uint64_t>(rank, 1, total);
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < BUCKETS; ++i) {
+                seen += buckets[i];
+                if (seen < rank) continue;
+                // the last bucket is open ended
+                std::uint64_t edge = i == BUCKETS - 1 ? maximum : upperEdge(i);
+                return std::chrono::nanoseconds(std::clamp(edge, minimum, maximum));
+            }
+            return max();
+        }
+
+        // {"count":..,"min_us":..,"mean_us":..,"p50_us":..,"p90_us":..,"p99_us":..,"p999_us":..,"max_us":..}
+        std::string toJson() const
+        {
+            auto us = [](std::chrono::nanoseconds value) {
+                return std::to_string(value.count() / 1000);
+            };
+            return "{\"count\":" + std::to_string(total) +
+                   ",\"min_us\":" + us(min()) +
+                   ",\"mean_us\":" + us(mean()) +
+                   ",\"p50_us\":" + us(percentile(50)) +
+                   ",\"p90_us\":" + us(percentile(90)) +
+                   ",\"p99_us\":" + us(percentile(99)) +
+                   ",\"p999_us\":" + us(percentile(99.9)) +
+                   ",\"max_us\":" + us(max()) + "}";
+        }
+
+        static std::size_t bucketFor(std::uint64_t ns)
+        {
+            if (ns < SUB_BUCKETS) return static_cast<std::size_t>(ns);
+            int msb = std::bit_width(ns) - 1;
+            if (msb >= MAX_BITS) return BUCKETS - 1;
+            int shift = msb - SUB_BITS;
+            std::uint64_t sub = (ns >> shift) & (SUB_BUCKETS - 1);
+            return static_cast<std::size_t>((msb - SUB_BITS + 1) * SUB_BUCKETS + sub);
+        }
+
+        static std::uint64_t upperEdge(std::size_t bucket)
+        {
+            if (bucket < SUB_BUCKETS) return bucket;
+            std::uint64_t group = bucket / SUB_BUCKETS;
+            std::uint64_t sub = bucket % SUB_BUCKETS;
+            int shift = static_cast<int>(group) - 1;
+            return ((SUB_BUCKETS + sub) << shift) + ((std::uint64_t{1} << shift) - 1);
+        }
+
+    private:
+        std::array<std::uint64_t, BUCKETS> buckets{};
+        std::uint64_t total = 0;
+        std::uint64_t minimum = 0;
+        std::uint64_t maximum = 0;
+        std::uint64_t sum = 0;
+};
+
+#endif // LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,31 @@
+#ifndef LOG_TIMING_HPP
+#define LOG_TIMING_HPP
+
+#include <spdlog/sinks/sink.h>
+#include <chrono>
+#include <memory>
+
+// Sink decorator that measures how long the calling thread spends writing log messages.
+// With the synchronous default logger the sinks run on the thread that logs, so the
+// control loop can tell how much of a tick went to logging.
+class TimedSink : public spdlog::sinks::sink
+{
+    public:
+        explicit TimedSink(std::shared_ptr<spdlog::sinks::sink> inner);
+
+        void log(const spdlog::details::log_msg& msg) override;
+        void flush() override;
+        void set_pattern(const std::string& pattern) override;
+        void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+        // total time this thread spent in timed sinks so far
+        static std::chrono::nanoseconds threadTotal();
+
+        // wraps every sink of the default logger, call before other threads log
+        static void install();
+
+    private:
+        std::shared_ptr<spdlog::sinks::sink> inner;
+};
+
+#endif // LOG_TIMING_HPP
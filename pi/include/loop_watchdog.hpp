@@ -0,0 +1,81 @@
+#ifndef LOOP_WATCHDOG_HPP
+#define LOOP_WATCHDOG_HPP
+
+#include "state_machine.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Watches the control loop from the outside.
+// Every zone tick is checked against a time budget; overruns are counted per state and the
+// slowest ticks are kept with the phase that took longest. A separate thread notices when
+// one loop iteration runs past the stall timeout and calls the stall handler (which should
+// cut the pumps) once per stall. The handler must not log: a blocked logger is one of the
+// stalls it has to get past. The stall is logged by the control thread when it resumes.
+class LoopWatchdog
+{
+    public:
+        struct Limits
+        {
+            std::chrono::nanoseconds tickBudget = std::chrono::milliseconds(20);
+            std::chrono::milliseconds stallTimeout{2000};
+        };
+        static constexpr std::size_t WORST_KEPT = 8;
+
+        LoopWatchdog(Limits limits, std::function<void()> onStall);
+        ~LoopWatchdog();
+
+        LoopWatchdog(const LoopWatchdog&) = delete;
+        LoopWatchdog& operator=(const LoopWatchdog&) = delete;
+
+        void start();//stall thread
+        void stop();//safe to call twice
+
+        // control thread: bracket one loop iteration, record every zone tick in between
+        void beginIteration();
+        void record(const TickTiming& timing);
+        void endIteration();
+
+        const Limits& limits() const;
+        uint64_t tickCount() const;//ticks recorded
+        uint64_t overrunCount() const;
+        uint64_t overrunCount(SystemState state) const;
+        uint64_t stallCount() const;//any thread
+        // slowest overruns, slowest first
+        const std::array<TickTiming, WORST_KEPT>& worst() const;
+        std::size_t worstCount() const;
+
+        // {"ticks":..,"overruns":..,"stalls":..,"budget_us":..,"per_state":{..},"worst":[{..},..]}
+        std::string summaryJson() const;
+
+    private:
+        void run();
+        void keepIfWorst(const TickTiming& timing);
+
+        Limits bounds;
+        std::function<void()> stallHandler;
+
+        // control thread
+        uint64_t ticks = 0;
+        std::array<uint64_t, STATE_COUNT> overruns{};
+        std::array<TickTiming, WORST_KEPT> slowest{};
+        std::size_t slowestCount = 0;
+        uint64_t stallsReported = 0;//stalls already logged by endIteration()
+
+        // steady_clock ticks at which the running iteration started, 0 when idle
+        std::atomic<std::chrono::steady_clock::rep> iterationStart{0};
+        std::atomic<uint64_t> stalls{0};
+
+        std::thread monitor;
+        std::mutex stopMutex;
+        std::condition_variable stopSignal;
+        bool stopping = false;
+};
+
+#endif // LOOP_WATCHDOG_HPP
@@ -0,0 +1,69 @@
+#ifndef MOISTURE_FILTER_HPP
+#define MOISTURE_FILTER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+enum class FilterKind
+{
+    MOVING_AVERAGE, // simple moving average over the window
+    EXPONENTIAL,    // EMA with alpha = 2 / (window + 1)
+    MEDIAN,         // sliding median, rejects single spikes
+    HAMPEL          // passes samples through unless they are outliers against median/MAD
+};
+
+// Incremental moisture filter, each add() costs the same regardless of the window size.
+// Median and Hampel keep a Fenwick tree over the valid moisture range quantized to
+// RESOLUTION, so order statistics are O(log bins) instead of O(window).
+class MoistureFilter
+{
+    public:
+        MoistureFilter(FilterKind kind, std::size_t window, double hampelThreshold = 3.0);
+
+        double add(double moisture);//feeds one sample, returns the filtered value
+        double value() const;//last filtered value, 0 before the first sample
+        void reset();
+
+        FilterKind kind() const;
+        std::size_t window() const;
+        std::size_t count() const;//samples currently in the window
+        double outlierThreshold() const;//hampel threshold in scaled MADs
+
+        static const char* kindToString(FilterKind kind);
+
+        static constexpr double MIN_VALUE = -5.0;   // same range as IrrigarionLogic::isReadingValid
+        static constexpr double MAX_VALUE = 105.0;
+        static constexpr double RESOLUTION = 0.05;
+
+    private:
+        double addMovingAverage(double moisture, double evicted, bool full);
+        double addExponential(double moisture);
+        double addOrderStatistic(double moisture, double evicted, bool full);
+
+        //Fenwick tree helpers (bins are 1-based inside the tree)
+        std::size_t toBin(double moisture) const;
+        double fromBin(std::size_t bin) const;
+        void treeAdd(std::size_t bin, int delta);
+        int treePrefix(std::size_t bin) const;//samples in bins [0, bin]
+        std::size_t treeKth(int k) const;//bin of the k-th smallest sample, k >= 1
+        double median() const;
+        double medianAbsoluteDeviation(std::size_t medianBin) const;
+
+        FilterKind filterKind;
+        std::size_t windowSize;
+        double hampelThreshold;
+
+        std::vector<double> samples;//circular window of raw samples
+        std::size_t next = 0;
+        std::size_t filled = 0;
+        double filtered = 0.0;
+
+        double sum = 0.0;//moving average
+        std::size_t sinceResum = 0;
+        double alpha;//exponential
+        std::vector<int> tree;//median and hampel
+        std::size_t treeHighBit = 0;
+};
+
+#endif // MOISTURE_FILTER_HPP
@@ -0,0 +1,84 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free multi-producer single-consumer ring (Vyukov style sequence cells).
+// Producers never block: tryPush() fails when the ring is full.
+// tryPop() and hasPending() must only be called from one consumer thread.
+template <typename T, std::size_t Capacity>
+class MpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+
+    public:
+        MpscQueue()
+        {
+            for (std::size_t i = 0; i < Capacity; ++i)
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        bool tryPush(const T& value)
+        {
+            std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+            while (true) {
+                Cell& cell = cells[pos & (Capacity - 1)];
+                std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+                if (diff == 0) {
+                    // cell is free for this lap, claim it
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        cell.value = value;
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false; // full, consumer has not freed this cell yet
+                } else {
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool tryPop(T& value)
+        {
+            Cell& cell = cells[dequeuePos & (Capacity - 1)];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            if (static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(dequeuePos + 1) < 0)
+                return false; // empty, or the producer of this cell has not finished writing
+
+            value = cell.value;
+            cell.sequence.store(dequeuePos + Capacity, std::memory_order_release);
+            ++dequeuePos;
+            return true;
+        }
+
+        // consumer thread only; true when the next tryPop() would succeed
+        bool hasPending() const
+        {
+            const Cell& cell = cells[dequeuePos & (Capacity - 1)];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            return static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(dequeuePos + 1) >= 0;
+        }
+
+        static constexpr std::size_t capacity() { return Capacity; }
+
+    private:
+        struct Cell {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        alignas(64) std::array<Cell, Capacity> cells;
+        alignas(64) std::atomic<std::size_t> enqueuePos{0};
+        alignas(64) std::size_t dequeuePos = 0;
+};
+
+#endif // MPSC_QUEUE_HPP
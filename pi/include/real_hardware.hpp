@@ -3,6 +3,7 @@
 
 #include "i_sensor_interface.hpp"
 #include "i_pump_interface.hpp"
+#include <atomic>
 
 class RealHardware : public ISensorInterface, public IPumpInterface {
 public:
@@ -16,6 +17,7 @@ public:
     double getHumid() override;
     bool isRainDetected() override;
     bool isHealthy() override;
+    SensorFrame readAll() override;
 
     // IPumpInterface implementation
     void activate() override;
@@ -23,7 +25,7 @@ public:
     bool isActive() override;
 
 private:
-    bool pumpState = false;
+    std::atomic<bool> pumpState{false};//deactivate() may come from another thread
 };
 
 #endif // REAL_HARDWARE_HPP
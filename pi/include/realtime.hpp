@@ -0,0 +1,35 @@
+#ifndef REALTIME_HPP
+#define REALTIME_HPP
+
+#include <cstddef>
+
+// Opt-in real-time setup for the control thread (Linux).
+// Each step is independent: one that the system refuses (usually missing CAP_SYS_NICE or
+// a low RLIMIT_MEMLOCK) is logged and skipped, the loop then keeps running without it.
+struct RealtimeOptions
+{
+    int priority = 0;                   // SCHED_FIFO priority 1..99, 0 keeps the normal scheduler
+    int cpu = -1;                       // core the thread is pinned to, -1 leaves the affinity alone
+    bool lockMemory = false;            // mlockall() current and future pages
+    std::size_t stackPrefaultBytes = 0; // stack touched up front so the loop never page faults on it
+};
+
+struct RealtimeStatus
+{
+    bool scheduled = false;
+    bool pinned = false;
+    bool memoryLocked = false;
+    bool stackPrefaulted = false;
+};
+
+class RealtimeThread
+{
+    public:
+        // Applies the options to the calling thread. Threads started afterwards inherit the
+        // scheduler and affinity, so call it once the helper threads are running.
+        static RealtimeStatus configure(const RealtimeOptions& options);
+
+        static RealtimeOptions defaults();//priority 50, last core, locked memory, 256 KiB of stack
+};
+
+#endif // REALTIME_HPP
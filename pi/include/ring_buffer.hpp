@@ -0,0 +1,67 @@
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Fixed-capacity history buffer that always exposes its contents as one contiguous span.
+// Every element is stored twice (at i and i + capacity), so the window oldest..newest
+// never wraps and readers get a plain array without copying. Storage is allocated once.
+template <typename T>
+class RingBuffer
+{
+    public:
+        explicit RingBuffer(std::size_t capacity)
+            : storage(2 * std::max<std::size_t>(1, capacity)),
+              bufferCapacity(std::max<std::size_t>(1, capacity)) {}
+
+        // Appends, dropping the oldest element once full
+        void push(const T& value)
+        {
+            storage[head] = value;
+            storage[head + bufferCapacity] = value;
+            head = (head + 1) % bufferCapacity;
+            if (count < bufferCapacity) ++count;
+        }
+
+        // Oldest to newest
+        std::span<const T> view() const
+        {
+            std::size_t start = (head + bufferCapacity - count) % bufferCapacity;
+            return std::span<const T>(storage.data() + start, count);
+        }
+
+        // Keeps the newest elements that fit, reallocates
+        void resize(std::size_t capacity)
+        {
+            capacity = std::max<std::size_t>(1, capacity);
+            if (capacity == bufferCapacity) return;
+
+            auto current = view();
+            std::size_t keep = std::min(current.size(), capacity);
+            std::vector<T> kept(current.end() - keep, current.end());
+
+            storage.assign(2 * capacity, T{});
+            bufferCapacity = capacity;
+            head = 0;
+            count = 0;
+            for (const T& value : kept) push(value);
+        }
+
+        void clear() { head = 0; count = 0; }
+
+        const T& back() const { return storage[(head + bufferCapacity - 1) % bufferCapacity]; }
+        std::size_t size() const { return count; }
+        std::size_t capacity() const { return bufferCapacity; }
+        bool empty() const { return count == 0; }
+
+    private:
+        std::vector<T> storage;
+        std::size_t bufferCapacity;
+        std::size_t head = 0; // next write position in [0, capacity)
+        std::size_t count = 0;
+};
+
+#endif // RING_BUFFER_HPP
@@ -0,0 +1,49 @@
+#ifndef SENSOR_ACQUISITION_HPP
+#define SENSOR_ACQUISITION_HPP
+
+#include "i_sensor_interface.hpp"
+#include "triple_buffer.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// Samples one sensor on its own thread at a fixed period and hands the newest frame to the
+// control loop through a triple buffer, so slow bus reads never delay a control tick.
+class SensorAcquisition
+{
+    public:
+        SensorAcquisition(ISensorInterface* sensor, std::chrono::milliseconds period);
+        ~SensorAcquisition();
+
+        SensorAcquisition(const SensorAcquisition&) = delete;
+        SensorAcquisition& operator=(const SensorAcquisition&) = delete;
+
+        void start();
+        void stop();//joins the thread, safe to call twice
+
+        // control thread only; true when frame was replaced by a new acquisition
+        bool latest(SensorFrame& frame);
+
+        std::chrono::milliseconds period() const;
+        uint64_t frameCount() const;//acquisitions published so far
+        uint64_t droppedCount() const;//frames overwritten before the control loop took them
+        uint64_t staleCount() const;//latest() calls that found nothing new
+
+    private:
+        void run();
+
+        ISensorInterface* sensor;
+        std::chrono::milliseconds samplePeriod;
+        TripleBuffer<SensorFrame> frames;
+        std::atomic<uint64_t> published{0};
+
+        std::thread worker;
+        std::mutex stopMutex;
+        std::condition_variable stopSignal;
+        bool stopping = false;
+};
+
+#endif // SENSOR_ACQUISITION_HPP
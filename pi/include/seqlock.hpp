@@ -0,0 +1,81 @@
+#ifndef SEQLOCK_HPP
+#define SEQLOCK_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer sequence lock for small trivially copyable values.
+// store() never blocks and never allocates. load() may be called from any number of
+// threads and retries while a store is in progress, so readers always see a whole value.
+// The payload is kept in relaxed atomic words, readers racing a writer are well defined.
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock needs a trivially copyable type");
+
+    public:
+        SeqLock()
+        {
+            store(T{});
+        }
+
+        // one writer at a time
+        void store(const T& value)
+        {
+            std::array<std::uint64_t, WORDS> buffer{};
+            std::memcpy(buffer.data(), &value, sizeof(T));
+
+            std::uint64_t seq = sequence.load(std::memory_order_relaxed);
+            sequence.store(seq + 1, std::memory_order_relaxed); // odd: write in progress
+            std::atomic_thread_fence(std::memory_order_release);
+            for (std::size_t i = 0; i < WORDS; ++i)
+                words[i].store(buffer[i], std::memory_order_relaxed);
+            sequence.store(seq + 2, std::memory_order_release);
+        }
+
+        T load() const
+        {
+            std::uint64_t loadedVersion;
+            return load(loadedVersion);
+        }
+
+        // also reports the version() of the value returned
+        T load(std::uint64_t& loadedVersion) const
+        {
+            std::array<std::uint64_t, WORDS> buffer;
+            std::uint64_t before;
+            std::uint64_t after;
+            do {
+                before = sequence.load(std::memory_order_acquire);
+                for (std::size_t i = 0; i < WORDS; ++i)
+                    buffer[i] = words[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = sequence.load(std::memory_order_relaxed);
+            } while ((before & 1) != 0 || before != after);
+            loadedVersion = before / 2;
+
+            // T may have member initializers, so build it from bytes rather than memcpy into it
+            std::array<std::byte, sizeof(T)> bytes;
+            std::memcpy(bytes.data(), buffer.data(), sizeof(T));
+            return std::bit_cast<T>(bytes);
+        }
+
+        // bumped by every store, the default value counts as the first
+        std::uint64_t version() const
+        {
+            return sequence.load(std::memory_order_acquire) / 2;
+        }
+
+    private:
+        static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+        std::atomic<std::uint64_t> sequence{0};
+        std::array<std::atomic<std::uint64_t>, WORDS> words{};
+};
+
+#endif // SEQLOCK_HPP
@@ -3,12 +3,16 @@
 
 #include "i_sensor_interface.hpp"
 #include "i_pump_interface.hpp"
+#include "i_clock_interface.hpp"
+#include <atomic>
 #include <random>
 #include <chrono>
+#include <ctime>
+#include <mutex>
 
 class SimulatedHardware : public ISensorInterface, public IPumpInterface {
 public:
-    SimulatedHardware();
+    explicit SimulatedHardware(IClockInterface* clock = nullptr);//real steady clock when no clock is given
     ~SimulatedHardware() override = default;
 
     // ISensorInterface implementation
@@ -18,6 +22,7 @@ public:
     double getHumid() override;
     bool isRainDetected() override;
     bool isHealthy() override;
+    SensorFrame readAll() override;
 
     // IPumpInterface implementation
     void activate() override;
@@ -30,8 +35,14 @@ public:
     
     enum class Scenario { DRY, WET, NORMAL };
     void setScenario(Scenario scenario);
+    // Fixed noise seed and start hour, so repeated runs on a VirtualClock are identical
+    void reseed(unsigned seed, int startHour = 0);
 
 private:
+    // The acquisition thread reads while the main loop advances the physics.
+    // Nothing logs while holding it, a stuck sink must not hold up readers or the pump.
+    mutable std::mutex stateMutex;
+
     // Simulation state
     double moistureLevel;
     double actualMoistureLevel;
@@ -41,18 +52,36 @@ private:
     bool isRaining;
     double rainIntensity;
     
-    bool pumpRunning;
+    std::atomic<bool> pumpRunning;//switched without stateMutex, deactivate() never waits on the physics
     bool systemHealthy;
     bool scenarioActive; // Lock temp/humidity when scenario is applied
 
     // Time tracking
+    IClockInterface* clock;
     std::chrono::steady_clock::time_point lastUpdateTime;
+    std::chrono::steady_clock::time_point lastLogTime;
+    std::chrono::steady_clock::time_point simStartTime;
+    std::time_t wallStartTime; // wall clock at simStartTime, drives the day/night cycle
 
     // Random number generation
     std::default_random_engine rng;
 
+    // Values of one PHYSICS log line, logged once stateMutex is released
+    struct PhysicsLog
+    {
+        double moisture = 0.0;
+        double target = 0.0;
+        bool pump = false;
+        bool rain = false;
+        double input = 0.0;
+        double evaporation = 0.0;
+        double deltaTime = 0.0;
+    };
+
     // Simulation helpers
-    void updateSensors(double deltaTime);
+    bool updateSensors(double deltaTime, PhysicsLog& log);//true when a log line is due
+    double moisturePercent() const;
+    int currentHourOfDay();
     double calculateTemperature(int hourOfDay);
     double calculateHumidity(int hourOfDay);
     
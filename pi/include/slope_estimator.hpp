@@ -0,0 +1,52 @@
+#ifndef SLOPE_ESTIMATOR_HPP
+#define SLOPE_ESTIMATOR_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+// Running least-squares fit of moisture against time over the last `window` samples.
+// Each add() is O(1): the regression sums are updated incrementally and re-based
+// once per window so neither rounding error nor the time offset can grow.
+class SlopeEstimator
+{
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        explicit SlopeEstimator(std::size_t window);
+
+        void add(TimePoint timeStamp, double moisture);
+        std::optional<double> slope() const;//%/min, nullopt until MIN_SAMPLES spread over time
+        double rSquared() const;//fit quality in [0, 1], 0 when there is no fit
+        std::size_t count() const;//samples currently in the window
+        std::size_t window() const;
+        void reset();
+
+        static constexpr std::size_t MIN_SAMPLES = 2;
+
+    private:
+        struct Sample
+        {
+            TimePoint timeStamp;
+            double moisture;
+        };
+
+        double secondsSinceOrigin(TimePoint timeStamp) const;
+        void rebase();//moves the origin to the oldest sample and re-sums
+
+        std::size_t windowSize;
+        std::vector<Sample> samples;//circular window
+        std::size_t next = 0;
+        std::size_t filled = 0;
+        std::size_t sinceRebase = 0;
+
+        TimePoint origin{};
+        double sumX = 0.0;
+        double sumY = 0.0;
+        double sumXX = 0.0;
+        double sumXY = 0.0;
+        double sumYY = 0.0;
+};
+
+#endif // SLOPE_ESTIMATOR_HPP
@@ -4,11 +4,21 @@
 #include "i_sensor_interface.hpp"
 #include "i_pump_interface.hpp"
 #include "irrigation_logic.hpp"
-#include <map>
+#include "i_clock_interface.hpp"
+#include "mpsc_queue.hpp"
+#include "ring_buffer.hpp"
+#include "moisture_filter.hpp"
+#include "slope_estimator.hpp"
+#include "config_store.hpp"
+#include "seqlock.hpp"
+#include "sensor_acquisition.hpp"
+#include "flight_recorder.hpp"
+#include <array>
 #include <chrono>
 #include <mutex>
 #include <atomic>
-#include <queue>
+
+class TraceWriter;
 
 enum class SystemState
 {
@@ -19,6 +29,56 @@ enum class SystemState
     ERROR,
     MANUAL
 };
+constexpr std::size_t STATE_COUNT = 6;
+
+// Consistent view of one zone, filled by the control loop once per tick.
+// Publishers read it through a seqlock instead of querying the hardware again.
+struct StatusSnapshot
+{
+    SystemState state = SystemState::IDLE;
+    double moisture = 0.0;          // latest raw reading
+    double filteredMoisture = 0.0;
+    double temperature = 0.0;
+    double humidity = 0.0;
+    bool pumpActive = false;
+    bool rainDetected = false;
+    std::uint64_t tick = 0;         // update() calls so far
+    std::chrono::steady_clock::time_point timeStamp{};
+};
+
+// Where the time of one update() went, measured on the real clock. Logging is only
+// measured once TimedSink::install() has wrapped the logger's sinks.
+enum class TickPhase
+{
+    COMMANDS,   // draining and applying commands
+    SENSORS,    // readSensors()
+    LOGIC,      // state handler and transition, without sensors, pump and logging
+    ACTUATION,  // switching the pump
+    LOGGING,
+    PUBLISH     // status snapshot
+};
+constexpr std::size_t TICK_PHASE_COUNT = 6;
+
+struct TickTiming
+{
+    SystemState state = SystemState::IDLE;  // state whose handler ran
+    std::uint64_t tick = 0;
+    std::chrono::nanoseconds total{0};
+    std::array<std::chrono::nanoseconds, TICK_PHASE_COUNT> phases{};
+
+    std::chrono::nanoseconds& phase(TickPhase p) { return phases[static_cast<std::size_t>(p)]; }
+    std::chrono::nanoseconds phase(TickPhase p) const { return phases[static_cast<std::size_t>(p)]; }
+
+    // the phase that took longest
+    TickPhase cause() const
+    {
+        std::size_t worst = 0;
+        for (std::size_t i = 1; i < TICK_PHASE_COUNT; ++i)
+            if (phases[i] > phases[worst]) worst = i;
+        return static_cast<TickPhase>(worst);
+    }
+};
+
 enum class Command
 {
     START_AUTO,
@@ -35,6 +95,23 @@ enum class PendingAction {
     EMERGENCY_STOP
 };
 
+// How often a state samples. Right after entering the state, burstSamples ticks run at
+// StateMachine::TICK_PERIOD so a transition is confirmed quickly, then ticks follow period.
+struct SamplingPolicy
+{
+    std::chrono::milliseconds period{100};
+    int burstSamples = 0;
+};
+
+// Moisture only moves fast while the pump runs, every other state samples slower
+constexpr std::array<SamplingPolicy, STATE_COUNT> DEFAULT_SAMPLING = {{
+    {std::chrono::seconds(5), 0},           // IDLE
+    {std::chrono::seconds(1), 5},           // MONITORING
+    {std::chrono::milliseconds(100), 0},    // WATERING
+    {std::chrono::seconds(60), 0},          // WAITING, capped by the wait period
+    {std::chrono::seconds(5), 3},           // ERROR, after the recovery interval
+    {std::chrono::milliseconds(500), 0}     // MANUAL
+}};
 
 struct IrrigationConfig {
     std::string zoneName = "Main Zone";
@@ -44,6 +121,13 @@ struct IrrigationConfig {
     int maxWateringSeconds = 60;
     int waitMinutes = 1; // Reduced for testing (was 15)
     int minWateringIntervalMinutes = 1; // Reduced for testing (was 30)
+    int historyWindow = 10; // sensor readings kept for filtering and trend analysis
+    FilterKind filterKind = FilterKind::MOVING_AVERAGE;
+    int filterWindow = 5; // samples the moisture filter looks at
+    double hampelThreshold = 3.0; // outlier limit in scaled MADs (HAMPEL only)
+    int slopeWindow = 100; // readings the watering trend is fitted over (10s at 100ms ticks)
+    std::array<SamplingPolicy, STATE_COUNT> sampling = DEFAULT_SAMPLING; // indexed by SystemState
+    int flightRecords = static_cast<int>(FlightRecorder::DEFAULT_CAPACITY); // 64 B each, fixed when the zone is created
 
     //presests:-
     static IrrigationConfig forClay(const std::string& name) {
@@ -92,38 +176,87 @@ struct IrrigationConfig {
     }
 };
 
+// What one update() pass works from, captured once at its start so every reading and
+// decision in the tick sees the same time and config
+struct TickContext
+{
+    std::chrono::steady_clock::time_point now;
+    uint64_t tick;                  // matches StatusSnapshot::tick
+    const IrrigationConfig& config;
+};
+
+// Sampling cost compared with ticking every state at StateMachine::TICK_PERIOD.
+// Clock time comes from the injected clock, CPU and bus time are measured on the real clock.
+struct SamplingReport
+{
+    std::chrono::duration<double> observed{0};             // clock time covered by the counters
+    std::array<uint64_t, STATE_COUNT> ticks{};             // update() calls per state
+    std::array<double, STATE_COUNT> baselineTicks{};       // calls a fixed TICK_PERIOD would have made
+    uint64_t sensorReads = 0;
+    std::chrono::nanoseconds averageTick{0};                // CPU time of one update()
+    std::chrono::nanoseconds averageSensorRead{0};          // bus time of one readSensors()
+    double ticksSavedPerDay = 0.0;
+    std::chrono::duration<double> cpuSavedPerDay{0};
+    std::chrono::duration<double> busSavedPerDay{0};
+};
+
 class StateMachine 
 {
     public:
-        StateMachine(ISensorInterface* sensor, IPumpInterface* pump, const IrrigationConfig& config);
+        StateMachine(ISensorInterface* sensor, IPumpInterface* pump, const IrrigationConfig& config,
+                     IClockInterface* clock = nullptr);//real steady clock when no clock is given
 
         void update();//main method to control handlers 
+        //time at which update() next has work to do (commands are woken separately)
+        std::chrono::steady_clock::time_point nextDeadline();
 
-        void sendCommnd(Command cmd);
+        static constexpr std::chrono::milliseconds TICK_PERIOD{100};//sampling period of the active states
+        static constexpr int ERROR_RECOVERY_SECONDS = 300;
+
+        bool sendCommnd(Command cmd);//lock-free, any thread; false when the command queue is full
+        //any thread, never logs: the pump is off when this returns, the next tick logs it and enters ERROR
+        //(EMERGENCY_STOP commands land here)
+        void emergencyStop();
+        bool emergencyStopPending() const;//tripped and not yet taken up by update()
+        bool hasPendingCommands() const;//control thread, a queued command or e-stop wants a tick now
         //helper methods
-        std::string stateToString(SystemState state);
-        std::string commandToString(Command cmd);
-        IrrigationConfig getConfig()const; 
-        void updateConfig(const IrrigationConfig& newconfig);
-        SystemState getCurrentState();
+        //static names, never allocate
+        static const char* stateToString(SystemState state);
+        static const char* commandToString(Command cmd);
+        static const char* phaseToString(TickPhase phase);
+        IrrigationConfig getConfig()const;//copy of the latest snapshot, any thread
+        void updateConfig(const IrrigationConfig& newconfig);//publishes a snapshot, applied on the next tick
+        SystemState getCurrentState();//state after the last tick, any thread
+        StatusSnapshot getStatus() const;//lock-free, any thread
+        //frames come from the acquisition thread instead of inline reads, before the first update()
+        void attachAcquisition(SensorAcquisition* acquisition);
+        //records every input and decision of this zone for TraceReplay, before the first update()
+        void attachTrace(TraceWriter* trace);
+        SamplingReport samplingReport() const;//control thread
+        const TickTiming& lastTick() const;//control thread, phases of the latest update()
+        const FlightRecorder& flightRecorder() const;//any thread may snapshot or dump it
+        bool takeErrorDump();//control thread, true once after each entry into ERROR
     private:
 
-        std::mutex commandMutex;
-        std::queue<Command> commands;
-        
-        mutable std::mutex configMutex;
+        static constexpr std::size_t COMMAND_QUEUE_CAPACITY = 64;
+        MpscQueue<Command, COMMAND_QUEUE_CAPACITY> commands;
         
         ISensorInterface* sensor;       
         IPumpInterface* pump;             
-        IrrigationConfig config;
+        IClockInterface* clock;
+        ConfigStore<IrrigationConfig> configStore;
+        const IrrigationConfig* activeConfig = nullptr;//snapshot pinned for the current tick
+        std::uint64_t appliedConfigVersion = 0;//snapshot the filters were last sized for
        
-        std::deque<sensorReading> recentReadings;
-        mutable std::mutex readingsMutex;
+        RingBuffer<sensorReading> recentReadings;
+        MoistureFilter moistureFilter;//fed with every reading, O(1) per sample
+        SlopeEstimator moistureTrend;//valid readings since watering started
 
         // Error tracking
         int consecutiveReadFailures = 0;
         int consecutiveLowReadings = 0;
-        bool pumpIsRunning = false;
+        bool pumpIsRunning = false;//last command sent to the pump, reported without asking the hardware
+        std::atomic<bool> estopLatched{false};//set by emergencyStop(), cleared by the next update()
 
         //time stamps
         std::chrono::steady_clock::time_point stateEntryTime;
@@ -131,7 +264,31 @@ class StateMachine
 
 
         SystemState currentState = SystemState::IDLE; //current System State IDLE as default
-        std::atomic<SystemState> publishedState; //atomic for safe reads from other threads
+        std::atomic<SystemState> publishedState{SystemState::IDLE}; //atomic for safe reads from other threads
+        SeqLock<StatusSnapshot> status;//written once per tick by update()
+        TickTiming lastTiming;
+        FlightRecorder flight;//one record per update()
+        std::uint8_t tickPumpFlags = 0;//FlightRecord pump bits of the running tick
+        bool errorDumpPending = false;
+        std::uint64_t tickCount = 0;
+        SensorFrame currentFrame;//latest acquisition, kept for the status snapshot
+        bool frameIsFresh = false;//currentFrame was acquired after the previous tick
+        SensorAcquisition* acquisition = nullptr;
+        TraceWriter* trace = nullptr;
+        std::uint64_t tracedConfigVersion = 0;//last snapshot written to the trace
+
+        // adaptive sampling bookkeeping
+        int ticksInState = 0;//update() calls since the current state was entered
+        SystemState intervalState = SystemState::IDLE;//state the clock time since the last tick belongs to
+        bool hasTicked = false;
+        std::chrono::steady_clock::time_point lastTickTime{};
+        std::chrono::duration<double> observedTime{0};
+        std::array<uint64_t, STATE_COUNT> ticksPerState{};
+        std::array<double, STATE_COUNT> baselinePerState{};
+        uint64_t sensorReadCount = 0;
+        std::chrono::nanoseconds tickCpuTime{0};
+        std::chrono::nanoseconds sensorBusTime{0};
+        std::chrono::nanoseconds actuationTime{0};//spent in pump activate/deactivate
 
         std::chrono::steady_clock::time_point lastWateringTime;
         std::chrono::steady_clock::time_point wateringStartTime;
@@ -139,24 +296,32 @@ class StateMachine
         PendingAction pendingAction = PendingAction::NONE;
 
         // creating state handlers
-        using StateHandler = SystemState (StateMachine::*)();
-        //map of handlers 
-        std::map<SystemState,StateHandler> stateHandlers;
-        void initHandlers();
+        using StateHandler = SystemState (StateMachine::*)(const TickContext&);
+        //handler table indexed by SystemState, one indirect call per tick
+        static const std::array<StateHandler, STATE_COUNT> stateHandlers;
 
         //a function for each state
-        SystemState IdleState();
-        SystemState MonitoringState();
-        SystemState WateringState();
-        SystemState WaitingState();
-        SystemState ErrorState();
-        SystemState ManualOverride();
+        SystemState IdleState(const TickContext& ctx);
+        SystemState MonitoringState(const TickContext& ctx);
+        SystemState WateringState(const TickContext& ctx);
+        SystemState WaitingState(const TickContext& ctx);
+        SystemState ErrorState(const TickContext& ctx);
+        SystemState ManualOverride(const TickContext& ctx);
 
         //command processing 
         void processCommand(Command cmd);
 
-        void addSensorReading(double moisture);
-        sensorReading createReading(double moisture);
+        const SensorFrame& readSensors();
+        void addSensorReading(const TickContext& ctx, double moisture);
+        double filteredMoisture();
+        void startPump();
+        void stopPump();
+        void publishStatus(const TickContext& ctx);//fills the status snapshot at the end of a tick
+        void recordFlight(const TickContext& ctx, SystemState state, std::uint8_t flags, unsigned commandCount);
+        void enterState(SystemState state, std::chrono::steady_clock::time_point now);
+        void recordTick(const TickContext& ctx, SystemState state, std::chrono::steady_clock::duration cpuTime);
+        void pinConfig();//loads this tick's snapshot and resizes history/filters when it changed
+        sensorReading createReading(const TickContext& ctx, double moisture);
 };
 
 #endif
\ No newline at end of file
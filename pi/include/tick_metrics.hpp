@@ -0,0 +1,31 @@
+#ifndef TICK_METRICS_HPP
+#define TICK_METRICS_HPP
+
+#include "latency_histogram.hpp"
+#include "state_machine.hpp"
+#include <array>
+#include <string>
+
+// update() latency per state, and per phase within each state, over every zone of the site.
+// Fed with StateMachine::lastTick() after each tick on the control thread; recording is a
+// handful of array increments and never allocates. Summaries are in nanoseconds, a tick is
+// usually well under a microsecond.
+class TickMetrics
+{
+    public:
+        void record(const TickTiming& timing);
+        void reset();
+
+        const LatencyHistogram& total(SystemState state) const;
+        const LatencyHistogram& phase(SystemState state, TickPhase phase) const;
+
+        // {"states":{"IDLE":{"count":..,"p50_ns":..,"p99_ns":..,"max_ns":..,
+        //   "phases":{"commands":{"p50_ns":..,"p99_ns":..,"max_ns":..},..}},..}}, states without ticks left out
+        std::string summaryJson() const;
+
+    private:
+        std::array<LatencyHistogram, STATE_COUNT> totals;
+        std::array<std::array<LatencyHistogram, TICK_PHASE_COUNT>, STATE_COUNT> phases;
+};
+
+#endif // TICK_METRICS_HPP
@@ -0,0 +1,123 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include "state_machine.hpp"
+#include "mpsc_queue.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Binary trace of everything a StateMachine decides from: the clock at each tick, the sensor
+// frames it consumed, drained commands, e-stops taken up and config snapshots, plus the
+// decision each tick made so a replay can be checked against the field.
+//
+// File: "IRTR", u16 version, u16 reserved, then events of one type byte and a payload.
+// Times are zigzag varints relative to the previous tick, doubles are stored exactly (host
+// byte order), a frame costs ~30 bytes and a tick without readings 3.
+enum class TraceEventType : std::uint8_t
+{
+    BEGIN = 1,      // start time and initial config, first event of a trace
+    TICK = 2,       // update() started at this clock time
+    CONFIG = 3,     // a new config snapshot was pinned by this tick
+    COMMAND = 4,    // drained by this tick
+    EMERGENCY_STOP = 5,
+    FRAME = 6,      // sensor frame consumed by this tick
+    DECISION = 7,   // state after the tick and FlightRecord pump bits
+    GAP = 8         // the writer ran out of buffers, events were lost before this one
+};
+
+struct TraceEvent
+{
+    TraceEventType type = TraceEventType::TICK;
+    std::chrono::steady_clock::time_point time{};  // BEGIN, TICK
+    IrrigationConfig config;                       // BEGIN, CONFIG
+    Command command = Command::START_AUTO;
+    SensorFrame frame;
+    bool fresh = false;                            // FRAME: new sample, not a repeat of the previous frame
+    SystemState state = SystemState::IDLE;         // DECISION
+    std::uint8_t pumpFlags = 0;                    // DECISION
+    std::uint64_t lost = 0;                        // GAP
+};
+
+// Records one zone. The control thread appends into preallocated chunks without locking or
+// allocating; full chunks are written to the file by a helper thread. When every chunk is
+// still queued for writing, events are counted as dropped and a GAP marks the hole.
+class TraceWriter
+{
+    public:
+        static constexpr std::size_t MAX_CHUNKS = 16;
+
+        explicit TraceWriter(const std::string& path, std::size_t chunkBytes = 64 * 1024, std::size_t chunks = 8);
+        ~TraceWriter();
+
+        TraceWriter(const TraceWriter&) = delete;
+        TraceWriter& operator=(const TraceWriter&) = delete;
+
+        bool isOpen() const;
+        void close();//writes what is buffered and stops the helper thread, safe to call twice
+
+        // control thread
+        void begin(std::chrono::steady_clock::time_point start, const IrrigationConfig& config);
+        void tick(std::chrono::steady_clock::time_point now);
+        void config(const IrrigationConfig& config);
+        void command(Command cmd);
+        void emergencyStop();
+        void frame(const SensorFrame& frame, bool fresh);
+        void decision(SystemState state, std::uint8_t pumpFlags);
+
+        std::uint64_t bytesWritten() const;//reached the file so far
+        std::uint64_t droppedEvents() const;
+
+    private:
+        std::uint8_t* reserve(std::size_t bytes);//room for one event, nullptr when dropped
+        void commit(const std::uint8_t* end);//event encoded up to end
+        void handOff();
+        void run();
+
+        std::FILE* file = nullptr;
+        std::vector<std::vector<std::uint8_t>> chunks;
+        std::array<std::size_t, MAX_CHUNKS> used{};
+        MpscQueue<std::uint32_t, MAX_CHUNKS> freeChunks;
+        MpscQueue<std::uint32_t, MAX_CHUNKS> fullChunks;
+
+        // control thread
+        std::int64_t current = -1;//chunk being filled, -1 while dropping
+        std::int64_t lastTickNs = 0;
+        std::uint64_t lost = 0;//dropped since the last GAP
+        std::atomic<std::uint64_t> dropped{0};
+
+        std::atomic<std::uint64_t> written{0};
+        std::thread worker;
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+        std::atomic<bool> stopping{false};
+};
+
+// Decodes a trace held in memory, events in file order
+class TraceReader
+{
+    public:
+        explicit TraceReader(std::span<const std::uint8_t> bytes);
+
+        static bool load(const std::string& path, std::vector<std::uint8_t>& bytes);
+
+        bool valid() const;//header matched
+        bool next(TraceEvent& event);//false at the end or on a truncated event
+        bool truncated() const;
+
+    private:
+        std::span<const std::uint8_t> data;
+        std::size_t offset = 0;
+        bool headerOk = false;
+        bool cut = false;
+        std::int64_t lastTickNs = 0;
+};
+
+#endif // TRACE_HPP
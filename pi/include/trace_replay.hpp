@@ -0,0 +1,44 @@
+#ifndef TRACE_REPLAY_HPP
+#define TRACE_REPLAY_HPP
+
+#include "trace.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+struct ReplayResult
+{
+    bool complete = false;              // BEGIN found, no GAP and no truncated event
+    std::uint64_t ticks = 0;
+    std::uint64_t frames = 0;
+    std::uint64_t commands = 0;
+    std::uint64_t emergencyStops = 0;
+    std::uint64_t configChanges = 0;
+    std::uint64_t divergences = 0;      // ticks whose state or pump action differs from the recording
+    std::uint64_t firstDivergence = 0;  // tick number, 0 when every decision matched
+    std::uint64_t missingFrames = 0;    // sensor reads the trace had no frame for
+    std::uint64_t unusedFrames = 0;     // recorded frames the replay never asked for
+    std::array<std::uint64_t, STATE_COUNT> ticksPerState{};
+    std::uint64_t transitions = 0;
+    std::uint64_t pumpStarts = 0;
+    std::chrono::nanoseconds simulated{0};  // clock time covered by the trace
+    std::chrono::nanoseconds elapsed{0};    // real time the replay took
+};
+
+// Feeds a recorded trace through a fresh StateMachine on a VirtualClock, as fast as the
+// CPU allows. Each tick gets the recorded clock time, config, commands, e-stops and sensor
+// frames before update() runs, so the same build makes the same decisions on every replay;
+// decisions that differ from the field (another build, changed irrigation logic) are counted.
+// The pump is simulated and reports what it was last told.
+class TraceReplay
+{
+    public:
+        // called after every replayed tick
+        using TickObserver = std::function<void(const StateMachine& machine)>;
+
+        static ReplayResult run(std::span<const std::uint8_t> trace, const TickObserver& observer = {});
+};
+
+#endif // TRACE_REPLAY_HPP
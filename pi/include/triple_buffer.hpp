@@ -0,0 +1,55 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer single-consumer handoff of the latest value.
+// The producer always has a slot to write into and the consumer always reads a complete
+// value, neither side ever waits. A value published before the consumer picked up the
+// previous one replaces it, which is counted as a drop.
+template <typename T>
+class TripleBuffer
+{
+    public:
+        // producer thread only
+        void write(const T& value)
+        {
+            slots[backIndex] = value;
+            std::uint8_t previous = middle.exchange(static_cast<std::uint8_t>(backIndex | FRESH_BIT),
+                                                    std::memory_order_acq_rel);
+            if (previous & FRESH_BIT) dropped.fetch_add(1, std::memory_order_relaxed);
+            backIndex = previous & INDEX_MASK;
+        }
+
+        // consumer thread only; false (and value untouched) when nothing new was published
+        bool read(T& value)
+        {
+            if (!(middle.load(std::memory_order_relaxed) & FRESH_BIT)) {
+                stale.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            std::uint8_t previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+            frontIndex = previous & INDEX_MASK;
+            value = slots[frontIndex];
+            return true;
+        }
+
+        std::uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+        std::uint64_t staleCount() const { return stale.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr std::uint8_t INDEX_MASK = 0x3;
+        static constexpr std::uint8_t FRESH_BIT = 0x4;
+
+        std::array<T, 3> slots{};
+        std::uint8_t backIndex = 0;              // producer owned
+        std::uint8_t frontIndex = 1;             // consumer owned
+        std::atomic<std::uint8_t> middle{2};     // shared slot index plus FRESH_BIT
+
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<std::uint64_t> stale{0};
+};
+
+#endif // TRIPLE_BUFFER_HPP
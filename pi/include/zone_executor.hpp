@@ -0,0 +1,65 @@
+#ifndef ZONE_EXECUTOR_HPP
+#define ZONE_EXECUTOR_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool for running one batch of independent tasks at a time.
+// Every worker owns a range of task indices, idle workers steal half of a busy worker's range.
+// The calling thread takes part as worker 0, so a pool of one thread runs everything inline.
+class ZoneExecutor
+{
+    public:
+        using TaskBody = std::function<void(std::size_t)>;
+
+        explicit ZoneExecutor(std::size_t threadCount = std::thread::hardware_concurrency());
+        ~ZoneExecutor();
+
+        ZoneExecutor(const ZoneExecutor&) = delete;
+        ZoneExecutor& operator=(const ZoneExecutor&) = delete;
+
+        // Runs body(i) once for every i in [0, taskCount) and returns when all are done
+        void parallelFor(std::size_t taskCount, const TaskBody& body);
+
+        std::size_t threadCount() const;
+        uint64_t stealCount() const;
+
+    private:
+        struct alignas(64) WorkQueue {
+            std::mutex mutex;
+            std::size_t begin = 0;
+            std::size_t end = 0;
+        };
+
+        void workerLoop(std::size_t self);
+        void runTasks(std::size_t self);
+        bool popLocal(std::size_t self, std::size_t& task);
+        bool steal(std::size_t self);
+
+        std::unique_ptr<WorkQueue[]> queues;
+        std::size_t workerCount;
+        std::vector<std::thread> workers;
+
+        std::atomic<std::size_t> remaining{0};
+        std::atomic<uint64_t> steals{0};
+
+        // Batch state, all guarded by batchMutex. A worker only enters runTasks while the
+        // batch is open, and parallelFor returns once none is left inside, so the next
+        // batch never resets a queue under a worker still stealing from the last one.
+        std::mutex batchMutex;
+        std::condition_variable batchReady;
+        std::condition_variable batchDone;
+        const TaskBody* body = nullptr;
+        uint64_t generation = 0;
+        std::size_t activeWorkers = 0;
+        bool batchOpen = false;
+        bool stopping = false;
+};
+
+#endif // ZONE_EXECUTOR_HPP
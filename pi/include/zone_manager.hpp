@@ -0,0 +1,75 @@
+#ifndef ZONE_MANAGER_HPP
+#define ZONE_MANAGER_HPP
+
+#include "state_machine.hpp"
+#include "i_clock_interface.hpp"
+#include "zone_executor.hpp"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Owns one StateMachine per irrigation zone, each with its own config, sensor and pump.
+// Hardware is owned by the caller and must outlive the manager.
+// Zones on a shared bus are updated one after another, all other zones may run in parallel.
+class ZoneManager
+{
+    public:
+        using ZoneId = std::size_t;
+        using PublishCallback = std::function<void(const std::string& topic, const std::string& payload)>;
+
+        explicit ZoneManager(IClockInterface* clock = nullptr);
+
+        ZoneId addZone(const IrrigationConfig& config, ISensorInterface* sensor, IPumpInterface* pump,
+                       std::optional<int> busId = std::nullopt);//zones with the same bus id share hardware
+        std::size_t zoneCount() const;
+        StateMachine& zone(ZoneId id);
+
+        void setExecutor(ZoneExecutor* executor);//nullptr runs zones on the calling thread
+        void updateAll();//runs one control tick on every zone
+        //ticks only the zones whose own deadline has arrived or that have a command waiting
+        void updateDue();
+        bool ticked(ZoneId id) const;//updated by the last updateAll() or updateDue()
+        std::chrono::steady_clock::time_point nextDeadline();//earliest deadline of all zones
+
+        //commands
+        bool sendCommand(ZoneId id, Command cmd);
+        void sendCommandToAll(Command cmd);
+        //routes "irrigation/command" to all zones and "irrigation/zones/<id>/command" to one zone
+        bool handleMessage(const std::string& topic, const std::string& payload);
+        static std::optional<Command> parseCommand(const std::string& payload);
+
+        //status
+        std::string statusJson(ZoneId id);
+        //publishes "irrigation/zones/<id>/status" per zone, zone 0 also on "irrigation/status"
+        void publishStatus(const PublishCallback& publish);
+
+        static std::string commandTopic(ZoneId id);
+        static std::string statusTopic(ZoneId id);
+
+    private:
+        struct Zone {
+            ISensorInterface* sensor;
+            IPumpInterface* pump;
+            std::optional<int> busId;
+            std::unique_ptr<StateMachine> machine;
+            std::chrono::steady_clock::time_point deadline{};//from the zone's last tick
+            bool due = true;//ticked by the current updateDue()
+        };
+
+        void rebuildShards();
+        void runTicks();//ticks every zone marked due
+        void tick(Zone& zone);
+
+        IClockInterface* clock;
+        std::vector<Zone> zones;
+
+        // a shard is the unit of parallel work: one zone, or every zone of one bus
+        ZoneExecutor* executor = nullptr;
+        std::vector<std::vector<ZoneId>> shards;
+        bool shardsDirty = true;
+};
+
+#endif // ZONE_MANAGER_HPP
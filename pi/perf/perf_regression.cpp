@@ -0,0 +1,467 @@
+// perf/perf_regression.cpp
+// Fixed simulator workloads checked against perf/baseline.json. Exits with 1 when a metric is
+// outside its tolerance. Allocations per tick do not depend on the machine and are checked by
+// every ctest run (perf_allocations). Timing is compared only against a baseline recorded on the
+// same host with the same build type. ctest registers it as perf_regression (label perf) where such
+// a baseline exists, with --require-timing so that a missing one fails instead of being skipped.
+//   perf_regression --baseline=<file> [--allocations-only] [--require-timing] [--host=<name>]
+//                   [--repetitions=N] [--out=<file>] [--update]
+#include "state_machine.hpp"
+#include "zone_manager.hpp"
+#include "simulated_hardware.hpp"
+#include "latency_histogram.hpp"
+#include "clock.hpp"
+#include "counting_allocator.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#ifndef PERF_BUILD_TYPE
+#define PERF_BUILD_TYPE "Unoptimized"
+#endif
+
+namespace {
+
+// Every metric of a workload, the direction says which way is worse
+enum class Better { HIGHER, LOWER };
+struct MetricSpec
+{
+    const char* name;
+    Better better;
+};
+constexpr MetricSpec METRICS[] = {
+    {"ticks_per_s", Better::HIGHER},    // update() calls per second spent in update()
+    {"p50_ns", Better::LOWER},          // update() latency
+    {"p99_ns", Better::LOWER},
+    {"allocs_per_tick", Better::LOWER}, // operator new calls inside update()
+};
+
+bool isAllocationMetric(const MetricSpec& spec)
+{
+    return std::string(spec.name) == "allocs_per_tick";
+}
+
+using Metrics = std::map<std::string, double>;
+
+// Counts allocations and time of the calls in between, kept on the stack of one workload
+class TickMeter
+{
+    public:
+        void begin()
+        {
+            allocationsBefore = AllocationCounter::count();
+            AllocationCounter::start();
+            started = std::chrono::steady_clock::now();
+        }
+        void end(std::uint64_t ticks)
+        {
+            busy += std::chrono::steady_clock::now() - started;
+            AllocationCounter::stop();
+            allocated += AllocationCounter::count() - allocationsBefore;
+            this->ticks += ticks;
+        }
+
+        Metrics metrics() const
+        {
+            double seconds = std::chrono::duration<double>(busy).count();
+            return {
+                {"ticks_per_s", seconds > 0 ? static_cast<double>(ticks) / seconds : 0.0},
+                {"p50_ns", static_cast<double>(latency.percentile(50).count())},
+                {"p99_ns", static_cast<double>(latency.percentile(99).count())},
+                {"allocs_per_tick", ticks ? static_cast<double>(allocated) / static_cast<double>(ticks) : 0.0},
+            };
+        }
+
+        LatencyHistogram latency;//per update(), from StateMachine::lastTick()
+
+    private:
+        std::chrono::steady_clock::time_point started;
+        std::chrono::steady_clock::duration busy{0};
+        std::uint64_t allocationsBefore = 0;
+        std::uint64_t allocated = 0;
+        std::uint64_t ticks = 0;
+};
+
+// One zone through a dry simulated day, ticking at its own sampling deadlines
+Metrics soilDay(const IrrigationConfig& config)
+{
+    VirtualClock clock;
+    SimulatedHardware hardware(&clock);
+    hardware.reseed(1, 6);  // the same day on every run, starting at dawn
+    hardware.setScenario(SimulatedHardware::Scenario::DRY);
+    StateMachine machine(&hardware, &hardware, config, &clock);
+    machine.sendCommnd(Command::START_AUTO);
+
+    TickMeter meter;
+    while (clock.now().time_since_epoch() < std::chrono::hours(24)) {
+        hardware.update();
+        meter.begin();
+        machine.update();
+        meter.end(1);
+        meter.latency.record(machine.lastTick().total);
+        clock.set(machine.nextDeadline());
+    }
+    return meter.metrics();
+}
+
+// Many zones of mixed soil, every zone ticked once per simulated second
+Metrics manyZones(std::size_t count, int rounds)
+{
+    VirtualClock clock;
+    std::vector<std::unique_ptr<SimulatedHardware>> hardware;
+    ZoneManager zones(&clock);
+    for (std::size_t i = 0; i < count; ++i) {
+        hardware.push_back(std::make_unique<SimulatedHardware>(&clock));
+        hardware.back()->reseed(static_cast<unsigned>(i) + 1, 6);
+        std::string name = "Zone " + std::to_string(i);
+        IrrigationConfig config = i % 4 == 0 ? IrrigationConfig::forLoam(name)
+                                : i % 4 == 1 ? IrrigationConfig::forClay(name)
+                                : i % 4 == 2 ? IrrigationConfig::forSandy(name)
+                                             : IrrigationConfig::forPeat(name);
+        zones.addZone(config, hardware.back().get(), hardware.back().get());
+    }
+    zones.sendCommandToAll(Command::START_AUTO);
+
+    TickMeter meter;
+    for (int round = 0; round < rounds; ++round) {
+        for (auto& sim : hardware) sim->update();
+        meter.begin();
+        zones.updateAll();
+        meter.end(count);
+        for (std::size_t id = 0; id < count; ++id) meter.latency.record(zones.zone(id).lastTick().total);
+        clock.advance(std::chrono::seconds(1));
+    }
+    return meter.metrics();
+}
+
+struct Workload
+{
+    std::string name;
+    std::function<Metrics()> run;
+};
+
+std::vector<Workload> workloads()
+{
+    return {
+        {"day_loam", [] { return soilDay(IrrigationConfig::forLoam("Loam")); }},
+        {"day_clay", [] { return soilDay(IrrigationConfig::forClay("Clay")); }},
+        {"day_sandy", [] { return soilDay(IrrigationConfig::forSandy("Sandy")); }},
+        {"day_peat", [] { return soilDay(IrrigationConfig::forPeat("Peat")); }},
+        {"zones_2000", [] { return manyZones(2000, 60); }},
+    };
+}
+
+// Best of the repetitions for timing, worst for allocations, so noise does not flip a result
+void keepBest(Metrics& best, const Metrics& run)
+{
+    for (const MetricSpec& spec : METRICS) {
+        auto it = best.find(spec.name);
+        double value = run.at(spec.name);
+        if (it == best.end()) {
+            best[spec.name] = value;
+        } else if (isAllocationMetric(spec)) {
+            it->second = std::max(it->second, value);
+        } else {
+            it->second = spec.better == Better::HIGHER ? std::max(it->second, value) : std::min(it->second, value);
+        }
+    }
+}
+
+// Minimal JSON for the baseline: nested objects of numbers, nothing else
+struct Json
+{
+    double number = 0.0;
+    std::map<std::string, Json> members;
+    bool isObject = false;
+
+    const Json* find(const std::string& key) const
+    {
+        auto it = members.find(key);
+        return it == members.end() ? nullptr : &it->second;
+    }
+};
+
+class JsonParser
+{
+    public:
+        explicit JsonParser(const std::string& text) : text(text) {}
+
+        bool parse(Json& value)
+        {
+            return parseValue(value) && (skip(), pos == text.size());
+        }
+
+    private:
+        void skip()
+        {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+        }
+
+        bool parseString(std::string& out)
+        {
+            skip();
+            if (pos >= text.size() || text[pos] != '"') return false;
+            auto close = text.find('"', pos + 1);
+            if (close == std::string::npos) return false;
+            out = text.substr(pos + 1, close - pos - 1);
+            pos = close + 1;
+            return true;
+        }
+
+        bool parseValue(Json& value)
+        {
+            skip();
+            if (pos >= text.size()) return false;
+            if (text[pos] != '{') {
+                char* end = nullptr;
+                value.number = std::strtod(text.c_str() + pos, &end);
+                if (end == text.c_str() + pos) return false;
+                pos = static_cast<std::size_t>(end - text.c_str());
+                return true;
+            }
+            value.isObject = true;
+            ++pos;
+            skip();
+            if (pos < text.size() && text[pos] == '}') { ++pos; return true; }
+            while (true) {
+                std::string key;
+                if (!parseString(key)) return false;
+                skip();
+                if (pos >= text.size() || text[pos++] != ':') return false;
+                if (!parseValue(value.members[key])) return false;
+                skip();
+                if (pos >= text.size()) return false;
+                char c = text[pos++];
+                if (c == '}') return true;
+                if (c != ',') return false;
+            }
+        }
+
+        const std::string& text;
+        std::size_t pos = 0;
+};
+
+std::string format(double value)
+{
+    char text[32];
+    std::snprintf(text, sizeof(text), value >= 100 ? "%.0f" : "%.3g", value);
+    return text;
+}
+
+// {"tolerance":{..},"allocs_per_tick":{"<workload>":..},
+//  "timing":{"<host>/<build>":{"<workload>":{"<metric>":..}}}}
+std::string toJson(const Json& tolerance, const std::map<std::string, double>& allocs,
+                   const std::map<std::string, std::map<std::string, Metrics>>& timing)
+{
+    std::ostringstream out;
+    out << "{\n  \"tolerance\": {";
+    bool first = true;
+    for (const auto& [name, value] : tolerance.members) {
+        out << (first ? "" : ", ") << "\"" << name << "\": " << value.number;
+        first = false;
+    }
+    out << "},\n  \"allocs_per_tick\": {";
+    first = true;
+    for (const auto& [workload, value] : allocs) {
+        out << (first ? "" : ", ") << "\"" << workload << "\": " << format(value);
+        first = false;
+    }
+    out << "},\n  \"timing\": {";
+    bool firstKey = true;
+    for (const auto& [key, results] : timing) {
+        out << (firstKey ? "\n" : ",\n") << "    \"" << key << "\": {";
+        bool firstWorkload = true;
+        for (const auto& [workload, metrics] : results) {
+            out << (firstWorkload ? "\n" : ",\n") << "      \"" << workload << "\": {";
+            bool firstMetric = true;
+            for (const MetricSpec& spec : METRICS) {
+                if (isAllocationMetric(spec)) continue;
+                out << (firstMetric ? "" : ", ") << "\"" << spec.name << "\": " << format(metrics.at(spec.name));
+                firstMetric = false;
+            }
+            out << "}";
+            firstWorkload = false;
+        }
+        out << "\n    }";
+        firstKey = false;
+    }
+    out << (timing.empty() ? "}\n}\n" : "\n  }\n}\n");
+    return out.str();
+}
+
+std::string hostName()
+{
+    char name[256] = {};
+    if (gethostname(name, sizeof(name) - 1) != 0 || name[0] == '\0') return "unknown";
+    return name;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::string baselinePath;
+    std::string outPath;
+    std::string host;
+    int repetitions = 0;  // 0 picks the default for the mode
+    bool update = false;
+    bool allocationsOnly = false;
+    bool requireTiming = false;//a missing timing baseline is a failure
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--baseline=", 0) == 0) baselinePath = arg.substr(11);
+        else if (arg.rfind("--out=", 0) == 0) outPath = arg.substr(6);
+        else if (arg.rfind("--host=", 0) == 0) host = arg.substr(7);
+        else if (arg.rfind("--repetitions=", 0) == 0) {
+            const char* first = arg.data() + 14;
+            const char* last = arg.data() + arg.size();
+            auto [end, ec] = std::from_chars(first, last, repetitions);
+            if (ec != std::errc() || end != last || repetitions < 1) {
+                std::fprintf(stderr, "invalid %s\n", arg.c_str());
+                return 2;
+            }
+        }
+        else if (arg == "--update") update = true;
+        else if (arg == "--allocations-only") allocationsOnly = true;
+        else if (arg == "--require-timing") requireTiming = true;
+    }
+    if (baselinePath.empty()) {
+        std::fprintf(stderr, "usage: %s --baseline=<file> [--allocations-only] [--require-timing] [--host=<name>] [--repetitions=N] "
+                             "[--out=<file>] [--update]\n", argv[0]);
+        return 2;
+    }
+    if (update) allocationsOnly = false;
+    // allocation counts do not vary between runs, timing keeps the best of several
+    if (repetitions == 0) repetitions = allocationsOnly ? 1 : 5;
+    if (host.empty()) host = hostName();
+    spdlog::set_level(spdlog::level::off);
+    // timing is only comparable on the same machine with the same build
+    const std::string timingKey = host + "/" + PERF_BUILD_TYPE;
+
+    Json baseline;
+    {
+        std::ifstream in(baselinePath);
+        std::stringstream text;
+        text << in.rdbuf();
+        if (!in || !JsonParser(text.str()).parse(baseline) || !baseline.isObject) {
+            std::fprintf(stderr, "%s: missing or malformed baseline\n", baselinePath.c_str());
+            if (!update) return 2;
+            baseline = Json{};
+            baseline.isObject = true;
+        }
+    }
+
+    std::map<std::string, Metrics> results;
+    for (const Workload& workload : workloads()) {
+        Metrics best;
+        for (int r = 0; r < repetitions; ++r) keepBest(best, workload.run());
+        results[workload.name] = best;
+    }
+
+    // every host's timing is kept, only this host and build is replaced
+    std::map<std::string, double> allocs;
+    if (const Json* stored = baseline.find("allocs_per_tick")) {
+        for (const auto& [workload, value] : stored->members) allocs[workload] = value.number;
+    }
+    std::map<std::string, std::map<std::string, Metrics>> timing;
+    if (const Json* stored = baseline.find("timing")) {
+        for (const auto& [key, entries] : stored->members)
+            for (const auto& [workload, metrics] : entries.members)
+                for (const MetricSpec& spec : METRICS)
+                    if (const Json* value = metrics.find(spec.name)) timing[key][workload][spec.name] = value->number;
+    }
+    Json tolerance;
+    if (const Json* stored = baseline.find("tolerance")) tolerance = *stored;
+    for (const MetricSpec& spec : METRICS) tolerance.members.try_emplace(spec.name);
+
+    if (!outPath.empty()) {
+        std::map<std::string, double> currentAllocs;
+        for (const auto& [workload, metrics] : results) currentAllocs[workload] = metrics.at("allocs_per_tick");
+        std::ofstream(outPath) << toJson(tolerance, currentAllocs,
+                                         allocationsOnly ? decltype(timing){} : decltype(timing){{timingKey, results}});
+    }
+    if (update) {
+        for (const auto& [workload, metrics] : results) allocs[workload] = metrics.at("allocs_per_tick");
+        timing[timingKey] = results;
+        std::ofstream(baselinePath) << toJson(tolerance, allocs, timing);
+        std::printf("perf_regression: baseline for %s written to %s\n", timingKey.c_str(), baselinePath.c_str());
+        return 0;
+    }
+
+    auto reference = timing.find(timingKey);
+    bool timingChecked = !allocationsOnly && reference != timing.end();
+    std::printf("perf_regression: %s against %s", allocationsOnly ? "allocations" : timingKey.c_str(),
+                baselinePath.c_str());
+    if (!allocationsOnly && !timingChecked)
+        std::printf(" (no timing baseline for %s: timing %s)", timingKey.c_str(),
+                    requireTiming ? "FAILS" : "reported only");
+    std::printf("\n\n%-12s %-16s %12s %12s %9s %14s  %s\n", "workload", "metric", "baseline", "current", "change",
+                "limit", "");
+
+    std::vector<std::string> regressions;
+    if (requireTiming && !allocationsOnly && !timingChecked)
+        regressions.push_back("no timing baseline for " + timingKey);
+    for (const auto& [workload, metrics] : results) {
+        for (const MetricSpec& spec : METRICS) {
+            bool allocationMetric = isAllocationMetric(spec);
+            if (allocationsOnly && !allocationMetric) continue;
+            double current = metrics.at(spec.name);
+            std::optional<double> stored;
+            if (allocationMetric) {
+                auto it = allocs.find(workload);
+                if (it != allocs.end()) stored = it->second;
+            } else if (timingChecked) {
+                auto it = reference->second.find(workload);
+                if (it != reference->second.end() && it->second.count(spec.name)) stored = it->second.at(spec.name);
+            }
+            if (!stored) {
+                std::printf("%-12s %-16s %12s %12s %9s %14s  %s\n", workload.c_str(), spec.name, "-",
+                            format(current).c_str(), "", "", allocationMetric || timingChecked ? "new" : "not compared");
+                if (requireTiming && timingChecked && !allocationMetric)
+                    regressions.push_back(workload + " " + spec.name + ": no baseline for " + timingKey);
+                continue;
+            }
+
+            double base = *stored;
+            double allowed = tolerance.members.at(spec.name).number;
+            // throughput may fall by the tolerance, latency may grow by it, allocations by an absolute count
+            double limit = allocationMetric ? base + allowed
+                         : spec.better == Better::HIGHER ? base * (1.0 - allowed)
+                                                         : base * (1.0 + allowed);
+            bool worse = spec.better == Better::HIGHER ? current < limit : current > limit;
+            double change = base != 0.0 ? (current - base) / base * 100.0 : 0.0;
+            char changeText[16];
+            std::snprintf(changeText, sizeof(changeText), "%+.1f%%", change);
+            std::string limitText = (spec.better == Better::HIGHER ? ">= " : "<= ") + format(limit);
+            std::printf("%-12s %-16s %12s %12s %9s %14s  %s\n", workload.c_str(), spec.name, format(base).c_str(),
+                        format(current).c_str(), base != 0.0 ? changeText : "", limitText.c_str(),
+                        worse ? "REGRESSION" : "ok");
+            if (worse) {
+                regressions.push_back(workload + " " + spec.name + ": " + format(base) + " -> " + format(current) +
+                                      " (" + (base != 0.0 ? changeText : "from 0") + ", limit " + limitText + ")");
+            }
+        }
+    }
+
+    if (regressions.empty()) {
+        std::printf("\nno regressions\n");
+        return 0;
+    }
+    std::printf("\n%zu regression(s):\n", regressions.size());
+    for (const std::string& line : regressions) std::printf("  %s\n", line.c_str());
+    std::printf("If the change is intended, refresh the baseline with: perf_regression --baseline=%s --host=%s --update\n",
+                baselinePath.c_str(), host.c_str());
+    return 1;
+}
@@ -0,0 +1,191 @@
+#include "async_sensor_reader.hpp"
+#include <algorithm>
+
+AsyncSensorReader::AsyncSensorReader(ISensorInterface* sensor, Deadlines deadlines)
+    : sensor(sensor), created(std::chrono::steady_clock::now())
+{
+    channels[static_cast<std::size_t>(SensorChannel::MOISTURE)].deadline = deadlines.moisture;
+    channels[static_cast<std::size_t>(SensorChannel::TEMPERATURE)].deadline = deadlines.temperature;
+    channels[static_cast<std::size_t>(SensorChannel::HUMIDITY)].deadline = deadlines.humidity;
+
+    for (std::size_t i = 0; i < SENSOR_CHANNEL_COUNT; ++i)
+        channels[i].worker = std::thread(&AsyncSensorReader::workerLoop, this, static_cast<SensorChannel>(i));
+}
+
+AsyncSensorReader::AsyncSensorReader(ISensorInterface* sensor)
+    : AsyncSensorReader(sensor, Deadlines{})
+{
+}
+
+AsyncSensorReader::~AsyncSensorReader()
+{
+    for (auto& channel : channels) {
+        {
+            std::lock_guard<std::mutex> lock(channel.mutex);
+            channel.stopping = true;
+        }
+        channel.signal.notify_all();
+    }
+    for (auto& channel : channels)
+        if (channel.worker.joinable()) channel.worker.join();
+}
+
+bool AsyncSensorReader::initialize()
+{
+    return sensor->initialize();
+}
+
+double AsyncSensorReader::getMoisture()
+{
+    return readChannel(SensorChannel::MOISTURE).value;
+}
+
+double AsyncSensorReader::getTemp()
+{
+    return readChannel(SensorChannel::TEMPERATURE).value;
+}
+
+double AsyncSensorReader::getHumid()
+{
+    return readChannel(SensorChannel::HUMIDITY).value;
+}
+
+bool AsyncSensorReader::isRainDetected()
+{
+    return sensor->isRainDetected();
+}
+
+bool AsyncSensorReader::isHealthy()
+{
+    return sensor->isHealthy();
+}
+
+SensorFrame AsyncSensorReader::readAll()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // start every conversion first so they overlap, then collect each against its own deadline
+    for (auto& channel : channels) request(channel);
+
+    std::array<Sample, SENSOR_CHANNEL_COUNT> samples;
+    for (std::size_t i = 0; i < SENSOR_CHANNEL_COUNT; ++i)
+        samples[i] = collect(channels[i], start, start + channels[i].deadline);
+    const Sample& moisture = samples[static_cast<std::size_t>(SensorChannel::MOISTURE)];
+    const Sample& temperature = samples[static_cast<std::size_t>(SensorChannel::TEMPERATURE)];
+    const Sample& humidity = samples[static_cast<std::size_t>(SensorChannel::HUMIDITY)];
+
+    SensorFrame frame;
+    frame.moisture = moisture.value;
+    frame.temperature = temperature.value;
+    frame.humidity = humidity.value;
+    frame.rainDetected = sensor->isRainDetected();
+    frame.healthy = sensor->isHealthy();
+    frame.timeStamp = start;
+    frame.validate();
+    frame.moistureValid = frame.moistureValid && moisture.valid;
+    frame.temperatureValid = frame.temperatureValid && temperature.valid;
+    frame.humidityValid = frame.humidityValid && humidity.valid;
+    frame.moistureAge = moisture.age;
+    frame.temperatureAge = temperature.age;
+    frame.humidityAge = humidity.age;
+    return frame;
+}
+
+uint64_t AsyncSensorReader::lateCount(SensorChannel channel) const
+{
+    const Channel& c = channels[static_cast<std::size_t>(channel)];
+    std::lock_guard<std::mutex> lock(c.mutex);
+    return c.late;
+}
+
+void AsyncSensorReader::request(Channel& channel)
+{
+    {
+        std::lock_guard<std::mutex> lock(channel.mutex);
+        // a result left over from an earlier read is older than this read, convert anew
+        if (channel.busy || channel.requested) return;
+        channel.requested = true;
+    }
+    channel.signal.notify_all();
+}
+
+AsyncSensorReader::Sample AsyncSensorReader::collect(Channel& channel, std::chrono::steady_clock::time_point readStart,
+                                                     std::chrono::steady_clock::time_point deadline)
+{
+    std::unique_lock<std::mutex> lock(channel.mutex);
+    // waits for this read's conversion; an older result is taken once nothing newer is running
+    channel.signal.wait_until(lock, deadline, [&channel, readStart]() {
+        return channel.hasResult && (channel.resultStarted >= readStart || (!channel.busy && !channel.requested));
+    });
+
+    bool converted = channel.hasResult && channel.resultStarted >= readStart;
+    if (channel.hasResult) {
+        channel.lastGood = channel.result;
+        channel.lastGoodTime = channel.resultTime;
+        channel.hasGood = true;
+        channel.hasResult = false;
+    }
+
+    Sample sample;
+    if (!converted) {
+        ++channel.late;
+        // reused or late value, or none at all yet: never reported as age 0
+        auto since = channel.hasGood ? channel.lastGoodTime : created;
+        auto age = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - since);
+        sample.age = std::max(age, std::chrono::microseconds(1));
+
+        // the channel is behind: convert again right away instead of at the next read
+        if (!channel.busy && !channel.requested) {
+            channel.requested = true;
+            channel.signal.notify_all();
+        }
+    }
+    sample.value = channel.lastGood;
+    sample.valid = channel.hasGood;
+    return sample;
+}
+
+AsyncSensorReader::Sample AsyncSensorReader::readChannel(SensorChannel channel)
+{
+    Channel& c = channels[static_cast<std::size_t>(channel)];
+    auto start = std::chrono::steady_clock::now();
+    request(c);
+    return collect(c, start, start + c.deadline);
+}
+
+void AsyncSensorReader::workerLoop(SensorChannel id)
+{
+    Channel& channel = channels[static_cast<std::size_t>(id)];
+    std::unique_lock<std::mutex> lock(channel.mutex);
+    while (true) {
+        channel.signal.wait(lock, [&channel]() { return channel.requested || channel.stopping; });
+        if (channel.stopping) return;
+        channel.requested = false;
+        channel.busy = true;
+        auto started = std::chrono::steady_clock::now();
+
+        // the blocking conversion runs without the lock, readers can time out meanwhile
+        lock.unlock();
+        double value = convert(id);
+        auto finished = std::chrono::steady_clock::now();
+        lock.lock();
+
+        channel.result = value;
+        channel.resultStarted = started;
+        channel.resultTime = finished;
+        channel.hasResult = true;
+        channel.busy = false;
+        channel.signal.notify_all();
+    }
+}
+
+double AsyncSensorReader::convert(SensorChannel channel)
+{
+    switch (channel) {
+        case SensorChannel::MOISTURE: return sensor->getMoisture();
+        case SensorChannel::TEMPERATURE: return sensor->getTemp();
+        case SensorChannel::HUMIDITY: return sensor->getHumid();
+    }
+    return 0.0;
+}
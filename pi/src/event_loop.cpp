@@ -0,0 +1,144 @@
+#include "event_loop.hpp"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <cerrno>
+#include <algorithm>
+#include <system_error>
+
+namespace {
+    constexpr uint64_t WAKE_EVENT = UINT64_MAX;
+
+    timespec toTimespec(std::chrono::nanoseconds ns)
+    {
+        auto secs = std::chrono::duration_cast<std::chrono::seconds>(ns);
+        return timespec{
+            static_cast<time_t>(secs.count()),
+            static_cast<long>((ns - secs).count())
+        };
+    }
+
+    void drainFd(int fd)
+    {
+        uint64_t count;
+        while (::read(fd, &count, sizeof(count)) == sizeof(count)) {}
+    }
+}
+
+EventLoop::EventLoop()
+{
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0)
+        throw std::system_error(errno, std::generic_category(), "epoll_create1");
+
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0)
+        throw std::system_error(errno, std::generic_category(), "eventfd");
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = WAKE_EVENT;
+    if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev) < 0)
+        throw std::system_error(errno, std::generic_category(), "epoll_ctl(eventfd)");
+}
+
+EventLoop::~EventLoop()
+{
+    for (auto& timer : timers)
+        ::close(timer.fd);
+    if (wakeFd >= 0) ::close(wakeFd);
+    if (epollFd >= 0) ::close(epollFd);
+}
+
+EventLoop::TimerId EventLoop::addTimer(Callback callback)
+{
+    int fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), "timerfd_create");
+
+    TimerId id = timers.size();
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = id;
+    if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        ::close(fd);
+        throw std::system_error(errno, std::generic_category(), "epoll_ctl(timerfd)");
+    }
+
+    timers.push_back(Timer{fd, std::move(callback)});
+    return id;
+}
+
+void EventLoop::armAt(TimerId timer, std::chrono::steady_clock::time_point deadline)
+{
+    // steady_clock is CLOCK_MONOTONIC on Linux, so the deadline can be used as an absolute expiry.
+    // An all-zero it_value would disarm the timer, past deadlines expire immediately.
+    auto sinceEpoch = std::max(deadline.time_since_epoch(),
+                               std::chrono::steady_clock::duration(1));
+    itimerspec spec{};
+    spec.it_value = toTimespec(sinceEpoch);
+    ::timerfd_settime(timers.at(timer).fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+void EventLoop::armEvery(TimerId timer, std::chrono::milliseconds period)
+{
+    itimerspec spec{};
+    spec.it_value = toTimespec(period);
+    spec.it_interval = toTimespec(period);
+    ::timerfd_settime(timers.at(timer).fd, 0, &spec, nullptr);
+}
+
+void EventLoop::disarm(TimerId timer)
+{
+    itimerspec spec{};
+    ::timerfd_settime(timers.at(timer).fd, 0, &spec, nullptr);
+}
+
+void EventLoop::setWakeHandler(Callback callback)
+{
+    wakeHandler = std::move(callback);
+}
+
+void EventLoop::wake()
+{
+    uint64_t one = 1;
+    [[maybe_unused]] auto written = ::write(wakeFd, &one, sizeof(one));
+}
+
+void EventLoop::run()
+{
+    running.store(true);
+    epoll_event events[8];
+
+    while (running.load()) {
+        int count = ::epoll_wait(epollFd, events, 8, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            throw std::system_error(errno, std::generic_category(), "epoll_wait");
+        }
+        wakeups.fetch_add(1, std::memory_order_relaxed);
+
+        for (int i = 0; i < count && running.load(); ++i) {
+            uint64_t source = events[i].data.u64;
+            if (source == WAKE_EVENT) {
+                drainFd(wakeFd);
+                if (wakeHandler) wakeHandler();
+            } else {
+                drainFd(timers[source].fd);
+                if (timers[source].callback) timers[source].callback();
+            }
+        }
+    }
+}
+
+void EventLoop::stop()
+{
+    running.store(false);
+    wake();
+}
+
+uint64_t EventLoop::wakeupCount() const
+{
+    return wakeups.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,87 @@
+#include "flight_recorder.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+
+FlightRecorder::FlightRecorder(std::size_t capacity)
+    : slots(std::bit_ceil(std::max<std::size_t>(2, capacity))),
+      mask(slots.size() - 1)
+{
+}
+
+void FlightRecorder::record(const FlightRecord& entry)
+{
+    std::uint64_t index = written.load(std::memory_order_relaxed);
+    slots[index & mask].store(entry);
+    written.store(index + 1, std::memory_order_release);
+}
+
+std::vector<FlightRecord> FlightRecorder::snapshot() const
+{
+    std::uint64_t end = written.load(std::memory_order_acquire);
+    std::uint64_t first = end > slots.size() ? end - slots.size() : 0;
+
+    std::vector<FlightRecord> records;
+    records.reserve(end - first);
+    for (std::uint64_t i = first; i < end; ++i) {
+        // record i is the (i / capacity + 1)th store into its slot after the default value;
+        // a later version means the writer lapped the slot while it was being copied
+        std::uint64_t version;
+        FlightRecord record = slots[i & mask].load(version);
+        if (version == i / slots.size() + 2) records.push_back(record);
+    }
+    return records;
+}
+
+bool FlightRecorder::latest(FlightRecord& entry) const
+{
+    std::uint64_t end = written.load(std::memory_order_acquire);
+    if (end == 0) return false;
+    entry = slots[(end - 1) & mask].load();
+    return true;
+}
+
+bool FlightRecorder::dump(const std::string& path, const std::string& zoneName, FlightDumpReason reason) const
+{
+    std::vector<FlightRecord> records = snapshot();
+
+    FlightDumpHeader header;
+    header.count = static_cast<std::uint32_t>(records.size());
+    header.reason = reason;
+    header.recorded = recorded();
+    std::strncpy(header.zone, zoneName.c_str(), sizeof(header.zone) - 1);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(FlightRecord)));
+    return static_cast<bool>(out);
+}
+
+bool FlightRecorder::load(const std::string& path, FlightDumpHeader& header, std::vector<FlightRecord>& records)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+
+    const FlightDumpHeader expected;
+    if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+        header.version != expected.version || header.recordSize != expected.recordSize)
+        return false;
+    header.zone[sizeof(header.zone) - 1] = '\0';
+
+    records.resize(header.count);
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(records.data()),
+                                     static_cast<std::streamsize>(records.size() * sizeof(FlightRecord))));
+}
+
+std::uint64_t FlightRecorder::recorded() const
+{
+    return written.load(std::memory_order_acquire);
+}
+
+std::size_t FlightRecorder::capacity() const
+{
+    return slots.size();
+}
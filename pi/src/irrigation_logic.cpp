@@ -1,11 +1,13 @@
 #include "irrigation_logic.hpp"
+#include "slope_estimator.hpp"
+#include <algorithm>
 
 bool IrrigarionLogic::isReadingValid(double moisture)
 {
     return moisture >= -5 && moisture <= 105;
 }
 
-double IrrigarionLogic::getFilteredMoisture(const std::deque<sensorReading>& readings)
+double IrrigarionLogic::getFilteredMoisture(std::span<const sensorReading> readings)
 {
     if (readings.empty()) return 0.0;
 
@@ -18,26 +20,15 @@ double IrrigarionLogic::getFilteredMoisture(const std::deque<sensorReading>& rea
     return sum / count;
 }
 
-std::optional<double> IrrigarionLogic::getMoistuerChangeRate(const std::deque<sensorReading>& readings)
+std::optional<double> IrrigarionLogic::getMoistuerChangeRate(std::span<const sensorReading> readings)
 {
-    if(readings.size() < 2)
-    return std::nullopt;
-
-    auto newest = readings.back();
-    auto oldest = readings.front();
-
-    if(!newest.isValid || !oldest.isValid)
-    return std::nullopt;
-
-    auto timeDiff = std::chrono::duration_cast<std::chrono::minutes>
-    (newest.timeStamp - oldest.timeStamp);
-
-    if (timeDiff.count() == 0)
-    return std::nullopt;
-
-    double moistureDiff = newest.moisturePercent - oldest.moisturePercent;
-
-    return moistureDiff/timeDiff.count();
+    // least-squares slope over every valid reading, invalid ones are skipped
+    SlopeEstimator estimator(readings.size());
+    for (const auto& reading : readings) {
+        if (reading.isValid)
+            estimator.add(reading.timeStamp, reading.moisturePercent);
+    }
+    return estimator.slope();
 }
 
 bool IrrigarionLogic::shouldStartWatering(
@@ -0,0 +1,49 @@
+#include "log_timing.hpp"
+#include <spdlog/spdlog.h>
+
+namespace {
+thread_local std::chrono::nanoseconds timeInSinks{0};
+}
+
+TimedSink::TimedSink(std::shared_ptr<spdlog::sinks::sink> inner)
+    : inner(std::move(inner))
+{
+    set_level(this->inner->level());
+}
+
+void TimedSink::log(const spdlog::details::log_msg& msg)
+{
+    auto start = std::chrono::steady_clock::now();
+    if (inner->should_log(msg.level)) inner->log(msg);
+    timeInSinks += std::chrono::steady_clock::now() - start;
+}
+
+void TimedSink::flush()
+{
+    auto start = std::chrono::steady_clock::now();
+    inner->flush();
+    timeInSinks += std::chrono::steady_clock::now() - start;
+}
+
+void TimedSink::set_pattern(const std::string& pattern)
+{
+    inner->set_pattern(pattern);
+}
+
+void TimedSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter)
+{
+    inner->set_formatter(std::move(formatter));
+}
+
+std::chrono::nanoseconds TimedSink::threadTotal()
+{
+    return timeInSinks;
+}
+
+void TimedSink::install()
+{
+    for (auto& sink : spdlog::default_logger()->sinks()) {
+        if (!std::dynamic_pointer_cast<TimedSink>(sink))
+            sink = std::make_shared<TimedSink>(sink);
+    }
+}
@@ -0,0 +1,178 @@
+#include "loop_watchdog.hpp"
+#include "logger.hpp"
+#include <algorithm>
+
+LoopWatchdog::LoopWatchdog(Limits limits, std::function<void()> onStall)
+    : bounds(limits),
+      stallHandler(std::move(onStall))
+{
+}
+
+LoopWatchdog::~LoopWatchdog()
+{
+    stop();
+}
+
+void LoopWatchdog::start()
+{
+    if (monitor.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = false;
+    }
+    monitor = std::thread(&LoopWatchdog::run, this);
+}
+
+void LoopWatchdog::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = true;
+    }
+    stopSignal.notify_all();
+    if (monitor.joinable()) monitor.join();
+}
+
+void LoopWatchdog::beginIteration()
+{
+    // never 0 on a running clock, 0 means idle
+    iterationStart.store(std::max<std::chrono::steady_clock::rep>(
+                             1, std::chrono::steady_clock::now().time_since_epoch().count()),
+                         std::memory_order_release);
+}
+
+void LoopWatchdog::endIteration()
+{
+    iterationStart.store(0, std::memory_order_release);
+
+    // the stall thread never logs, a stuck sink may be what stalled us
+    uint64_t stalled = stalls.load(std::memory_order_relaxed);
+    if (stalled != stallsReported) {
+        stallsReported = stalled;
+        spdlog::error("Control loop stalled for over {}ms - pumps were forced off",
+                      bounds.stallTimeout.count());
+    }
+}
+
+void LoopWatchdog::record(const TickTiming& timing)
+{
+    ++ticks;
+    if (timing.total <= bounds.tickBudget) return;
+
+    ++overruns[static_cast<std::size_t>(timing.state)];
+    keepIfWorst(timing);
+}
+
+void LoopWatchdog::keepIfWorst(const TickTiming& timing)
+{
+    if (slowestCount == WORST_KEPT && timing.total <= slowest[WORST_KEPT - 1].total) return;
+
+    // sorted insert into a fixed array, the fastest entry falls off the end
+    std::size_t at = std::min(slowestCount, WORST_KEPT - 1);
+    while (at > 0 && slowest[at - 1].total < timing.total) {
+        slowest[at] = slowest[at - 1];
+        --at;
+    }
+    slowest[at] = timing;
+    slowestCount = std::min(slowestCount + 1, WORST_KEPT);
+
+    spdlog::warn("Tick overrun: {} tick {} took {}us (budget {}us), mostly {}",
+                 StateMachine::stateToString(timing.state), timing.tick,
+                 std::chrono::duration_cast<std::chrono::microseconds>(timing.total).count(),
+                 std::chrono::duration_cast<std::chrono::microseconds>(bounds.tickBudget).count(),
+                 StateMachine::phaseToString(timing.cause()));
+}
+
+void LoopWatchdog::run()
+{
+    // checks a few times per timeout so a stall is caught at most a quarter late
+    auto interval = std::max(std::chrono::milliseconds(1), bounds.stallTimeout / 4);
+    std::chrono::steady_clock::rep reportedStart = 0;
+
+    std::unique_lock<std::mutex> lock(stopMutex);
+    while (!stopSignal.wait_for(lock, interval, [this]() { return stopping; })) {
+        auto started = iterationStart.load(std::memory_order_acquire);
+        if (started == 0 || started == reportedStart) continue;
+
+        auto running = std::chrono::steady_clock::now().time_since_epoch() -
+                       std::chrono::steady_clock::duration(started);
+        if (running < bounds.stallTimeout) continue;
+
+        reportedStart = started;  // once per stalled iteration
+        // cut first and do not log here: the control thread may be stuck inside a sink,
+        // endIteration() reports the stall once it gets going again
+        lock.unlock();
+        if (stallHandler) stallHandler();
+        stalls.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+}
+
+const LoopWatchdog::Limits& LoopWatchdog::limits() const
+{
+    return bounds;
+}
+
+uint64_t LoopWatchdog::tickCount() const
+{
+    return ticks;
+}
+
+uint64_t LoopWatchdog::overrunCount() const
+{
+    uint64_t total = 0;
+    for (uint64_t count : overruns) total += count;
+    return total;
+}
+
+uint64_t LoopWatchdog::overrunCount(SystemState state) const
+{
+    return overruns[static_cast<std::size_t>(state)];
+}
+
+uint64_t LoopWatchdog::stallCount() const
+{
+    return stalls.load(std::memory_order_relaxed);
+}
+
+const std::array<TickTiming, LoopWatchdog::WORST_KEPT>& LoopWatchdog::worst() const
+{
+    return slowest;
+}
+
+std::size_t LoopWatchdog::worstCount() const
+{
+    return slowestCount;
+}
+
+std::string LoopWatchdog::summaryJson() const
+{
+    auto us = [](std::chrono::nanoseconds value) {
+        return std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(value).count());
+    };
+
+    std::string json = "{\"ticks\":" + std::to_string(ticks) +
+                       ",\"overruns\":" + std::to_string(overrunCount()) +
+                       ",\"stalls\":" + std::to_string(stallCount()) +
+                       ",\"budget_us\":" + us(bounds.tickBudget) +
+                       ",\"per_state\":{";
+    for (std::size_t i = 0; i < STATE_COUNT; ++i) {
+        if (i > 0) json += ",";
+        json += std::string("\"") + StateMachine::stateToString(static_cast<SystemState>(i)) + "\":" +
+                std::to_string(overruns[i]);
+    }
+    json += "},\"worst\":[";
+    for (std::size_t i = 0; i < slowestCount; ++i) {
+        const TickTiming& timing = slowest[i];
+        if (i > 0) json += ",";
+        json += std::string("{\"state\":\"") + StateMachine::stateToString(timing.state) + "\"" +
+                ",\"tick\":" + std::to_string(timing.tick) +
+                ",\"total_us\":" + us(timing.total) +
+                ",\"cause\":\"" + StateMachine::phaseToString(timing.cause()) + "\"";
+        for (std::size_t p = 0; p < TICK_PHASE_COUNT; ++p)
+            json += std::string(",\"") + StateMachine::phaseToString(static_cast<TickPhase>(p)) + "_us\":" + us(timing.phases[p]);
+        json += "}";
+    }
+    json += "]}";
+    return json;
+}
@@ -1,43 +1,205 @@
 #include <iostream>
-#include <thread>
 #include <chrono>
+#include <vector>
+#include <algorithm>
+#include <charconv>
 
 #include "logger.hpp"
 #include "hardware_factory.hpp"
 #include "state_machine.hpp"
+#include "zone_manager.hpp"
+#include "zone_executor.hpp"
 #include "mqtt_handler.hpp"
+#include "event_loop.hpp"
+#include "sensor_acquisition.hpp"
+#include "async_sensor_reader.hpp"
+#include "realtime.hpp"
+#include "latency_histogram.hpp"
+#include "loop_watchdog.hpp"
+#include "tick_metrics.hpp"
+#include "log_timing.hpp"
+#include "trace.hpp"
 #include "simulated_hardware.hpp" // For casting if needed to access simulation-specific methods
 
+// Soil presets are cycled through when more than one zone is simulated
+static IrrigationConfig presetForZone(std::size_t index)
+{
+    std::string name = "Zone " + std::to_string(index);
+    switch (index % 4) {
+        case 0: return IrrigationConfig::forLoam(name);
+        case 1: return IrrigationConfig::forClay(name);
+        case 2: return IrrigationConfig::forSandy(name);
+        default: return IrrigationConfig::forPeat(name);
+    }
+}
+
+// Integer after the '=' of a --flag=N argument, false when it is empty or not a number
+static bool parseFlagValue(const std::string& arg, std::size_t prefixLength, int& value)
+{
+    const char* first = arg.data() + prefixLength;
+    const char* last = arg.data() + arg.size();
+    auto [end, ec] = std::from_chars(first, last, value);
+    return ec == std::errc() && end == last;
+}
+
 int main(int argc, char* argv[])
 {
     //Initialize Logger
     spdlog::set_level(spdlog::level::info);
+    TimedSink::install(); // lets the watchdog tell logging apart from the rest of a tick
     spdlog::info("Starting Smart Irrigation System...");
 
     // Hardware Setup (Factory)
-    // Check command line arguments for simulation flag
+    // Check command line arguments for simulation flag and zone count
     bool useSimulator = true; // Default to simulator for now
-    if (argc > 1 && std::string(argv[1]) == "--real") {
-        useSimulator = false;
-        spdlog::info("Mode: REAL HARDWARE");
-    } else {
-        spdlog::info("Mode: SIMULATOR");
+    std::size_t zoneCount = 1;
+    std::size_t threadCount = 1;
+    int acquireMs = 0; // 0 reads sensors inline in the control tick
+    int sensorDeadlineMs = 0; // 0 waits for every conversion
+    bool realtime = false;
+    RealtimeOptions rtOptions = RealtimeThread::defaults();
+    LoopWatchdog::Limits watchdogLimits;
+    std::string flightDir = ".";
+    int flightRecords = static_cast<int>(FlightRecorder::DEFAULT_CAPACITY);
+    std::string traceDir; // empty records no traces
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        int value = 0;
+        bool valid = true;
+        if (arg == "--real") {
+            useSimulator = false;
+        } else if (arg.rfind("--zones=", 0) == 0) {
+            valid = parseFlagValue(arg, 8, value);
+            if (valid) zoneCount = std::max(1, value);
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            valid = parseFlagValue(arg, 10, value);
+            if (valid) threadCount = std::max(1, value);
+        } else if (arg.rfind("--acquire-ms=", 0) == 0) {
+            valid = parseFlagValue(arg, 13, value);
+            if (valid) acquireMs = std::max(0, value);
+        } else if (arg.rfind("--sensor-deadline-ms=", 0) == 0) {
+            valid = parseFlagValue(arg, 21, value);
+            if (valid) sensorDeadlineMs = std::max(0, value);
+        } else if (arg == "--rt") {
+            realtime = true;
+        } else if (arg.rfind("--rt-priority=", 0) == 0) {
+            realtime = true;
+            valid = parseFlagValue(arg, 14, value);
+            if (valid) rtOptions.priority = std::clamp(value, 1, 99);
+        } else if (arg.rfind("--rt-cpu=", 0) == 0) {
+            realtime = true;
+            valid = parseFlagValue(arg, 9, value);
+            if (valid) rtOptions.cpu = value;
+        } else if (arg.rfind("--tick-budget-ms=", 0) == 0) {
+            valid = parseFlagValue(arg, 17, value);
+            if (valid) watchdogLimits.tickBudget = std::chrono::milliseconds(std::max(1, value));
+        } else if (arg.rfind("--stall-ms=", 0) == 0) {
+            valid = parseFlagValue(arg, 11, value);
+            if (valid) watchdogLimits.stallTimeout = std::chrono::milliseconds(std::max(10, value));
+        } else if (arg.rfind("--flight-records=", 0) == 0) {
+            valid = parseFlagValue(arg, 17, value);
+            if (valid) flightRecords = std::max(2, value);
+        } else if (arg.rfind("--flight-dir=", 0) == 0) {
+            flightDir = arg.substr(13);
+        } else if (arg.rfind("--trace-dir=", 0) == 0) {
+            traceDir = arg.substr(12);
+        }
+        if (!valid) {
+            spdlog::error("Invalid value in {}, expected an integer", arg);
+            return 1;
+        }
+    }
+    if (!useSimulator && zoneCount > 1) {
+        spdlog::warn("Real hardware drives a single zone, ignoring --zones={}", zoneCount);
+        zoneCount = 1;
+    }
+    spdlog::info("Mode: {} ({} zone(s))", useSimulator ? "SIMULATOR" : "REAL HARDWARE", zoneCount);
+
+    std::vector<HardwareBundle> hardware;
+    for (std::size_t i = 0; i < zoneCount; ++i) {
+        hardware.push_back(HardwareFactory::createHardware(useSimulator));
+
+        if (!hardware.back().sensor->initialize()) {
+            spdlog::error("Failed to initialize sensors!");
+            return 1;
+        }
+        if (!hardware.back().pump->initialize()) {
+            spdlog::error("Failed to initialize pump!");
+            return 1;
+        }
+    }
+
+    // Sensors as the zones see them, optionally behind per-channel deadlines.
+    // Declared after the hardware so the readers stop before the sensors they wrap go away.
+    std::vector<std::unique_ptr<AsyncSensorReader>> asyncSensors;
+    std::vector<ISensorInterface*> sensors;
+    for (auto& bundle : hardware) {
+        sensors.push_back(bundle.sensor.get());
+        if (sensorDeadlineMs > 0) {
+            // slow conversions fall back to their last good value instead of holding up the reader
+            std::chrono::milliseconds deadline(sensorDeadlineMs);
+            asyncSensors.push_back(std::make_unique<AsyncSensorReader>(
+                sensors.back(), AsyncSensorReader::Deadlines{deadline, deadline, deadline}));
+            sensors.back() = asyncSensors.back().get();
+        }
     }
 
-    auto hardware = HardwareFactory::createHardware(useSimulator);
-    
-    if (!hardware.sensor->initialize()) {
-        spdlog::error("Failed to initialize sensors!");
-        return 1;
+    //Configuration & State Machines
+    ZoneManager zones;
+    for (std::size_t i = 0; i < zoneCount; ++i) {
+        // A single zone keeps the default config
+        IrrigationConfig config = zoneCount == 1 ? IrrigationConfig{} : presetForZone(i);
+        config.flightRecords = flightRecords;
+        zones.addZone(config, sensors[i], hardware[i].pump.get());
     }
-    if (!hardware.pump->initialize()) {
-        spdlog::error("Failed to initialize pump!");
-        return 1;
+
+    // Optional acquisition thread per zone, the control tick then never waits on the sensor bus
+    std::vector<std::unique_ptr<SensorAcquisition>> acquisitions;
+    if (acquireMs > 0) {
+        for (std::size_t i = 0; i < zoneCount; ++i) {
+            acquisitions.push_back(std::make_unique<SensorAcquisition>(
+                sensors[i], std::chrono::milliseconds(acquireMs)));
+            zones.zone(i).attachAcquisition(acquisitions.back().get());
+            acquisitions.back()->start();
+        }
     }
 
-    //Configuration & State Machine
-    IrrigationConfig config; // Default config
-    StateMachine stateMachine(hardware.sensor.get(), hardware.pump.get(), config);
+    // Optional input trace per zone for trace_replay, written by a helper thread per zone
+    std::vector<std::unique_ptr<TraceWriter>> traces;
+    if (!traceDir.empty()) {
+        for (std::size_t i = 0; i < zoneCount; ++i) {
+            traces.push_back(std::make_unique<TraceWriter>(traceDir + "/trace_z" + std::to_string(i) + ".irt"));
+            if (traces.back()->isOpen()) zones.zone(i).attachTrace(traces.back().get());
+        }
+    }
+
+    // Zone updates are sharded across worker threads when asked for
+    ZoneExecutor executor(threadCount);
+    zones.setExecutor(&executor);
+
+    auto forEachSimulator = [useSimulator, &hardware](auto&& action) {
+        if (!useSimulator) return;
+        for (auto& bundle : hardware) {
+            auto sim = std::static_pointer_cast<SimulatedHardware>(bundle.hardwareInstance);
+            if (sim) action(*sim);
+        }
+    };
+
+    // Flight recorder dumps, decoded with flight_decode
+    auto dumpFlight = [&zones, &flightDir](std::size_t id, FlightDumpReason reason) {
+        const FlightRecorder& recorder = zones.zone(id).flightRecorder();
+        std::string path = flightDir + "/flight_z" + std::to_string(id) +
+                           (reason == FlightDumpReason::ERROR ? "_error_" : "_request_") +
+                           std::to_string(recorder.recorded()) + ".bin";
+        if (recorder.dump(path, zones.zone(id).getConfig().zoneName, reason)) {
+            spdlog::info("Zone {} flight recorder written to {}", id, path);
+        } else {
+            spdlog::error("Zone {} flight recorder could not be written to {}", id, path);
+        }
+    };
+
+    // Event loop outlives the MQTT client, its callback wakes the loop
+    EventLoop loop;
 
     //MQTT Setup
     std::string broker = "tcp://localhost:1883";
@@ -50,73 +212,109 @@ int main(int argc, char* argv[])
         spdlog::warn("Failed to connect to MQTT broker - continuing in offline mode");
     }
 
-    // Wiring MQTT callbacks to StateMachine
-    mqtt.setCallback([&stateMachine, useSimulator, &hardware](std::string topic, std::string payload) {
+    // Wiring MQTT callbacks to the zones
+    mqtt.setCallback([&zones, &forEachSimulator, &loop, &dumpFlight](std::string topic, std::string payload) {
         spdlog::info("MQTT Command received: {} -> {}", topic, payload);
-        
-        if (payload == "START") {
-            stateMachine.sendCommnd(Command::START_AUTO);
-        } else if (payload == "STOP") {
-            stateMachine.sendCommnd(Command::EMERGENCY_STOP);
-        } else if (payload == "MANUAL_ON") {
-            stateMachine.sendCommnd(Command::ENABLE_MANUAL);
-        } else if (payload == "MANUAL_OFF") {
-            stateMachine.sendCommnd(Command::DISABLE_MANUAL);
+
+        if (zones.handleMessage(topic, payload)) {
+            // routed to one or all zones
         } else if (payload == "SCENARIO_DRY") {
-            if (useSimulator) {
-                auto sim = std::static_pointer_cast<SimulatedHardware>(hardware.hardwareInstance);
-                if (sim) sim->setScenario(SimulatedHardware::Scenario::DRY);
-            }
+            forEachSimulator([](SimulatedHardware& sim) { sim.setScenario(SimulatedHardware::Scenario::DRY); });
         } else if (payload == "SCENARIO_WET") {
-            if (useSimulator) {
-                auto sim = std::static_pointer_cast<SimulatedHardware>(hardware.hardwareInstance);
-                if (sim) sim->setScenario(SimulatedHardware::Scenario::WET);
-            }
+            forEachSimulator([](SimulatedHardware& sim) { sim.setScenario(SimulatedHardware::Scenario::WET); });
         } else if (payload == "SCENARIO_NORMAL") {
-            if (useSimulator) {
-                auto sim = std::static_pointer_cast<SimulatedHardware>(hardware.hardwareInstance);
-                if (sim) sim->setScenario(SimulatedHardware::Scenario::NORMAL);
-            }
+            forEachSimulator([](SimulatedHardware& sim) { sim.setScenario(SimulatedHardware::Scenario::NORMAL); });
+        } else if (payload == "FLIGHT_DUMP") {
+            // the recorders are safe to copy while the control loop keeps writing
+            for (std::size_t id = 0; id < zones.zoneCount(); ++id) dumpFlight(id, FlightDumpReason::REQUESTED);
         }
+        // React right away instead of waiting for the next deadline
+        loop.wake();
     });
 
     // Main Loop
     spdlog::info("System Initialized. Entering main loop...");
-    
-    auto lastPublishTime = std::chrono::steady_clock::now();
-
-    while (true) {
-        if (useSimulator) {
-            auto sim = std::static_pointer_cast<SimulatedHardware>(hardware.hardwareInstance);
-            if (sim) {
-                sim->update();
-            }
+
+    auto advanceSimulation = [&forEachSimulator]() {
+        forEachSimulator([](SimulatedHardware& sim) { sim.update(); });
+    };
+
+    // A loop iteration stuck past the stall timeout switches every pump off from the watchdog thread
+    LoopWatchdog watchdog(watchdogLimits, [&zones]() {
+        for (std::size_t id = 0; id < zones.zoneCount(); ++id) zones.zone(id).emergencyStop();
+    });
+    watchdog.start();
+
+    // update() latency per state and phase since the last summary
+    auto tickMetrics = std::make_unique<TickMetrics>();
+
+    // Control tick: runs at the earliest zone deadline, or immediately on a command,
+    // and only ticks the zones that are due
+    EventLoop::TimerId controlTimer{};
+    std::chrono::steady_clock::time_point scheduledTick = std::chrono::steady_clock::now();
+    LatencyHistogram tickJitter;  // how late each deadline tick started, command wakeups excluded
+    auto controlTick = [&]() {
+        watchdog.beginIteration();
+        advanceSimulation();
+        zones.updateDue();
+        for (std::size_t id = 0; id < zones.zoneCount(); ++id) {
+            if (!zones.ticked(id)) continue;
+            const TickTiming& timing = zones.zone(id).lastTick();
+            watchdog.record(timing);
+            tickMetrics->record(timing);
+        }
+        watchdog.endIteration();
+        // after the iteration so the file write is not charged to the ticks
+        for (std::size_t id = 0; id < zones.zoneCount(); ++id) {
+            if (zones.zone(id).takeErrorDump()) dumpFlight(id, FlightDumpReason::ERROR);
         }
+        scheduledTick = zones.nextDeadline();
+        loop.armAt(controlTimer, scheduledTick);
+    };
+    controlTimer = loop.addTimer([&]() {
+        tickJitter.record(std::chrono::steady_clock::now() - scheduledTick);
+        controlTick();
+    });
+    loop.setWakeHandler(controlTick);
+    loop.armAt(controlTimer, scheduledTick);
 
-        stateMachine.update();
-
-        // Publish Status (every 5 seconds)
-        auto now = std::chrono::steady_clock::now();
-        if (std::chrono::duration_cast<std::chrono::seconds>(now - lastPublishTime).count() >= 5) {
-            
-            std::string status = "{";
-            status += "\"s\":" + std::to_string(static_cast<int>(stateMachine.getCurrentState())) + ",";
-            status += "\"m\":" + std::to_string(hardware.sensor->getMoisture()) + ",";
-            status += "\"t\":" + std::to_string(hardware.sensor->getTemp()) + ",";
-            status += "\"h\":" + std::to_string(hardware.sensor->getHumid()) + ",";
-            status += "\"p\":" + std::to_string(hardware.pump->isActive() ? 1 : 0) + ",";
-            status += "\"r\":" + std::to_string(hardware.sensor->isRainDetected() ? 1 : 0);
-            status += "}";
-
-            mqtt.publish("irrigation/status", status);
-            lastPublishTime = now;
+    // Publish Status (every 5 seconds)
+    EventLoop::TimerId publishTimer = loop.addTimer([&]() {
+        watchdog.beginIteration();
+        advanceSimulation();
+        zones.publishStatus([&mqtt](const std::string& topic, const std::string& payload) {
+            mqtt.publish(topic, payload);
+        });
+        // jitter of the ticks since the last publish
+        mqtt.publish("irrigation/metrics/jitter", tickJitter.toJson());
+        tickJitter.reset();
+        mqtt.publish("irrigation/metrics/watchdog", watchdog.summaryJson());
+        mqtt.publish("irrigation/metrics", tickMetrics->summaryJson());
+        tickMetrics->reset();
+        watchdog.endIteration();
+    });
+    loop.armEvery(publishTimer, std::chrono::seconds(5));
+
+    // Sampling savings against a fixed 100ms tick (hourly)
+    EventLoop::TimerId samplingTimer = loop.addTimer([&]() {
+        for (std::size_t id = 0; id < zones.zoneCount(); ++id) {
+            SamplingReport report = zones.zone(id).samplingReport();
+            spdlog::info("Zone {} sampling: {:.0f} ticks/day saved, CPU {:.3f}s/day, bus {:.3f}s/day",
+                         id, report.ticksSavedPerDay, report.cpuSavedPerDay.count(),
+                         report.busSavedPerDay.count());
         }
+    });
+    loop.armEvery(samplingTimer, std::chrono::hours(1));
 
-        // D. Loop Delay
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
+    // Every helper thread is running by now, so only the control thread becomes real-time
+    if (realtime) RealtimeThread::configure(rtOptions);
+
+    loop.run();
 
     // Cleanup
+    watchdog.stop();
+    for (auto& trace : traces) trace->close();
+    for (auto& acquisition : acquisitions) acquisition->stop();
     mqtt.disconnect();
     return 0;
-}
\ No newline at end of file
+}
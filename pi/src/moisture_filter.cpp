@@ -0,0 +1,191 @@
+#include "moisture_filter.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const std::size_t BIN_COUNT =
+        static_cast<std::size_t>((MoistureFilter::MAX_VALUE - MoistureFilter::MIN_VALUE) / MoistureFilter::RESOLUTION) + 1;
+
+    // MAD to standard deviation for normally distributed noise
+    constexpr double MAD_SCALE = 1.4826;
+}
+
+MoistureFilter::MoistureFilter(FilterKind kind, std::size_t window, double hampelThreshold)
+    : filterKind(kind),
+      windowSize(std::max<std::size_t>(1, window)),
+      hampelThreshold(hampelThreshold),
+      samples(std::max<std::size_t>(1, window)),
+      alpha(2.0 / (static_cast<double>(std::max<std::size_t>(1, window)) + 1.0))
+{
+    if (kind == FilterKind::MEDIAN || kind == FilterKind::HAMPEL) {
+        tree.assign(BIN_COUNT + 1, 0);
+        treeHighBit = 1;
+        while (treeHighBit * 2 <= BIN_COUNT) treeHighBit *= 2;
+    }
+}
+
+double MoistureFilter::add(double moisture)
+{
+    bool full = filled == windowSize;
+    double evicted = samples[next];
+    samples[next] = moisture;
+    next = (next + 1) % windowSize;
+    if (!full) ++filled;
+
+    switch (filterKind) {
+        case FilterKind::MOVING_AVERAGE: filtered = addMovingAverage(moisture, evicted, full); break;
+        case FilterKind::EXPONENTIAL:    filtered = addExponential(moisture); break;
+        case FilterKind::MEDIAN:
+        case FilterKind::HAMPEL:         filtered = addOrderStatistic(moisture, evicted, full); break;
+    }
+    return filtered;
+}
+
+double MoistureFilter::value() const
+{
+    return filtered;
+}
+
+void MoistureFilter::reset()
+{
+    next = 0;
+    filled = 0;
+    filtered = 0.0;
+    sum = 0.0;
+    sinceResum = 0;
+    std::fill(tree.begin(), tree.end(), 0);
+}
+
+FilterKind MoistureFilter::kind() const
+{
+    return filterKind;
+}
+
+std::size_t MoistureFilter::window() const
+{
+    return windowSize;
+}
+
+std::size_t MoistureFilter::count() const
+{
+    return filled;
+}
+
+double MoistureFilter::outlierThreshold() const
+{
+    return hampelThreshold;
+}
+
+const char* MoistureFilter::kindToString(FilterKind kind)
+{
+    switch (kind) {
+        case FilterKind::MOVING_AVERAGE: return "MOVING_AVERAGE";
+        case FilterKind::EXPONENTIAL: return "EXPONENTIAL";
+        case FilterKind::MEDIAN: return "MEDIAN";
+        case FilterKind::HAMPEL: return "HAMPEL";
+    }
+    return "UNKNOWN";
+}
+
+double MoistureFilter::addMovingAverage(double moisture, double evicted, bool full)
+{
+    sum += moisture;
+    if (full) sum -= evicted;
+
+    // Re-sum once per window so rounding error cannot build up, amortized O(1)
+    if (++sinceResum >= windowSize) {
+        sum = 0.0;
+        for (std::size_t i = 0; i < filled; ++i) sum += samples[i];
+        sinceResum = 0;
+    }
+    return sum / static_cast<double>(filled);
+}
+
+double MoistureFilter::addExponential(double moisture)
+{
+    if (filled == 1) return moisture;
+    return alpha * moisture + (1.0 - alpha) * filtered;
+}
+
+double MoistureFilter::addOrderStatistic(double moisture, double evicted, bool full)
+{
+    if (full) treeAdd(toBin(evicted), -1);
+    std::size_t bin = toBin(moisture);
+    treeAdd(bin, +1);
+
+    double med = median();
+    if (filterKind == FilterKind::MEDIAN) return med;
+
+    // Hampel: replace the sample by the median when it is too far out
+    std::size_t medianBin = toBin(med);
+    double mad = medianAbsoluteDeviation(medianBin);
+    double deviation = std::abs(fromBin(bin) - med);
+    if (deviation > hampelThreshold * MAD_SCALE * mad && deviation > RESOLUTION) return med;
+    return moisture;
+}
+
+std::size_t MoistureFilter::toBin(double moisture) const
+{
+    double clamped = std::clamp(moisture, MIN_VALUE, MAX_VALUE);
+    return static_cast<std::size_t>(std::lround((clamped - MIN_VALUE) / RESOLUTION));
+}
+
+double MoistureFilter::fromBin(std::size_t bin) const
+{
+    return MIN_VALUE + static_cast<double>(bin) * RESOLUTION;
+}
+
+void MoistureFilter::treeAdd(std::size_t bin, int delta)
+{
+    for (std::size_t i = bin + 1; i < tree.size(); i += i & (~i + 1))
+        tree[i] += delta;
+}
+
+int MoistureFilter::treePrefix(std::size_t bin) const
+{
+    int total = 0;
+    for (std::size_t i = std::min(bin + 1, tree.size() - 1); i > 0; i -= i & (~i + 1))
+        total += tree[i];
+    return total;
+}
+
+std::size_t MoistureFilter::treeKth(int k) const
+{
+    // binary lifting: largest position whose prefix count is < k
+    std::size_t pos = 0;
+    for (std::size_t step = treeHighBit; step > 0; step >>= 1) {
+        if (pos + step < tree.size() && tree[pos + step] < k) {
+            pos += step;
+            k -= tree[pos];
+        }
+    }
+    return pos; // 1-based pos + 1, minus 1 for the bin index
+}
+
+double MoistureFilter::median() const
+{
+    int n = static_cast<int>(filled);
+    double lower = fromBin(treeKth((n + 1) / 2));
+    if (n % 2 == 1) return lower;
+    double upper = fromBin(treeKth(n / 2 + 1));
+    return (lower + upper) / 2.0;
+}
+
+double MoistureFilter::medianAbsoluteDeviation(std::size_t medianBin) const
+{
+    // smallest distance d (in bins) such that half the samples lie within medianBin +- d
+    int half = static_cast<int>((filled + 1) / 2);
+    auto within = [&](std::size_t d) {
+        std::size_t low = medianBin >= d ? medianBin - d : 0;
+        int below = low > 0 ? treePrefix(low - 1) : 0;
+        return treePrefix(medianBin + d) - below;
+    };
+
+    std::size_t lo = 0, hi = BIN_COUNT;
+    while (lo < hi) {
+        std::size_t mid = (lo + hi) / 2;
+        if (within(mid) >= half) hi = mid;
+        else lo = mid + 1;
+    }
+    return static_cast<double>(lo) * RESOLUTION;
+}
@@ -71,7 +71,8 @@ void MqttHandler::onConnect(void* context, MQTTAsync_successData* response) {
     
     MqttHandler* handler = static_cast<MqttHandler*>(context);
     handler->subscribe("irrigation/command");
-    spdlog::info("MQTT subscribed successfully to irrigation/command!");
+    handler->subscribe("irrigation/zones/+/command");
+    spdlog::info("MQTT subscribed successfully to irrigation/command and irrigation/zones/+/command!");
 }
 
 void MqttHandler::onConnectFailure(void* context, MQTTAsync_failureData* response) 
@@ -106,5 +107,6 @@ void MqttHandler::onReconnected(void* context, char* cause)
 {
     MqttHandler* handler = static_cast<MqttHandler*>(context);
     handler->subscribe("irrigation/command");
+    handler->subscribe("irrigation/zones/+/command");
     spdlog::info("MQTT reconnected and subscribed successfully!");
 }
@@ -29,6 +29,11 @@ bool RealHardware::isHealthy() {
     return true;
 }
 
+SensorFrame RealHardware::readAll() {
+    // Stub: the channel reads go into one bus transaction once the drivers exist
+    return readEachChannel(std::chrono::steady_clock::now());
+}
+
 void RealHardware::activate() {
     spdlog::info("RealHardware: Pump ON (Stub)");
     pumpState = true;
@@ -36,7 +41,7 @@ void RealHardware::activate() {
 }
 
 void RealHardware::deactivate() {
-    spdlog::info("RealHardware: Pump OFF (Stub)");
+    // not logged: this is the e-stop and stall cut-off path, which must not wait on a sink
     pumpState = false;
     // TODO: Write to GPIO
 }
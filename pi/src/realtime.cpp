@@ -0,0 +1,79 @@
+#include "realtime.hpp"
+#include <spdlog/spdlog.h>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+// Touches every page of a stack sized block, kept out of line so it really lands on the stack
+[[gnu::noinline]] void prefaultStack(std::size_t bytes)
+{
+    volatile unsigned char* block = static_cast<volatile unsigned char*>(__builtin_alloca(bytes));
+    long page = sysconf(_SC_PAGESIZE);
+    for (std::size_t offset = 0; offset < bytes; offset += static_cast<std::size_t>(page))
+        block[offset] = 0;
+}
+
+}
+
+RealtimeOptions RealtimeThread::defaults()
+{
+    RealtimeOptions options;
+    options.priority = 50;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    options.cpu = cores > 1 ? static_cast<int>(cores - 1) : 0;
+    options.lockMemory = true;
+    options.stackPrefaultBytes = 256 * 1024;
+    return options;
+}
+
+RealtimeStatus RealtimeThread::configure(const RealtimeOptions& options)
+{
+    RealtimeStatus status;
+
+    // lock first, the prefaulted stack then stays resident
+    if (options.lockMemory) {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+            status.memoryLocked = true;
+        } else {
+            spdlog::warn("RT: mlockall failed: {}", std::strerror(errno));
+        }
+    }
+
+    if (options.stackPrefaultBytes > 0) {
+        prefaultStack(options.stackPrefaultBytes);
+        status.stackPrefaulted = true;
+    }
+
+    if (options.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(options.cpu, &set);
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (rc == 0) {
+            status.pinned = true;
+        } else {
+            spdlog::warn("RT: pinning to CPU {} failed: {}", options.cpu, std::strerror(rc));
+        }
+    }
+
+    if (options.priority > 0) {
+        sched_param param{};
+        param.sched_priority = options.priority;
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc == 0) {
+            status.scheduled = true;
+        } else {
+            spdlog::warn("RT: SCHED_FIFO priority {} refused: {}", options.priority, std::strerror(rc));
+        }
+    }
+
+    spdlog::info("RT: fifo={} pinned={} mlock={} stack={}KiB",
+                 status.scheduled, status.pinned, status.memoryLocked,
+                 status.stackPrefaulted ? options.stackPrefaultBytes / 1024 : 0);
+    return status;
+}
@@ -0,0 +1,78 @@
+#include "sensor_acquisition.hpp"
+#include "logger.hpp"
+
+SensorAcquisition::SensorAcquisition(ISensorInterface* sensor, std::chrono::milliseconds period)
+    : sensor(sensor),
+      samplePeriod(period)
+{
+}
+
+SensorAcquisition::~SensorAcquisition()
+{
+    stop();
+}
+
+void SensorAcquisition::start()
+{
+    if (worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = false;
+    }
+    worker = std::thread(&SensorAcquisition::run, this);
+    spdlog::info("Sensor acquisition started ({} ms period)", samplePeriod.count());
+}
+
+void SensorAcquisition::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = true;
+    }
+    stopSignal.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+bool SensorAcquisition::latest(SensorFrame& frame)
+{
+    return frames.read(frame);
+}
+
+std::chrono::milliseconds SensorAcquisition::period() const
+{
+    return samplePeriod;
+}
+
+uint64_t SensorAcquisition::frameCount() const
+{
+    return published.load(std::memory_order_relaxed);
+}
+
+uint64_t SensorAcquisition::droppedCount() const
+{
+    return frames.droppedCount();
+}
+
+uint64_t SensorAcquisition::staleCount() const
+{
+    return frames.staleCount();
+}
+
+void SensorAcquisition::run()
+{
+    auto nextSample = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(stopMutex);
+    while (!stopping) {
+        // the bus read happens without holding the stop lock
+        lock.unlock();
+        frames.write(sensor->readAll());
+        published.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+
+        // fixed rate, a slow read shortens the following wait instead of shifting the schedule
+        nextSample += samplePeriod;
+        auto now = std::chrono::steady_clock::now();
+        if (nextSample < now) nextSample = now;
+        stopSignal.wait_until(lock, nextSample, [this]() { return stopping; });
+    }
+}
@@ -3,8 +3,9 @@
 #include <algorithm>
 #include <ctime>
 #include <spdlog/spdlog.h>
+#include "clock.hpp"
 
-SimulatedHardware::SimulatedHardware()
+SimulatedHardware::SimulatedHardware(IClockInterface* clock)
     : moistureLevel(500.0),
       actualMoistureLevel(500.0),
       humidity(50.0),
@@ -13,74 +14,119 @@ SimulatedHardware::SimulatedHardware()
       rainIntensity(0.0),
       pumpRunning(false),
       systemHealthy(true),
-      scenarioActive(false)
+      scenarioActive(false),
+      clock(clock ? clock : &SteadyClock::instance())
 {
     std::random_device rd;
     rng = std::default_random_engine(rd());
-    lastUpdateTime = std::chrono::steady_clock::now();
+    lastUpdateTime = this->clock->now();
+    lastLogTime = lastUpdateTime;
+    simStartTime = lastUpdateTime;
+    wallStartTime = std::time(nullptr);
 }
 
 bool SimulatedHardware::initialize() {
-    lastUpdateTime = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(stateMutex);
+    lastUpdateTime = clock->now();
     return true;
 }
 
 // Sensor Interface Implementation
 double SimulatedHardware::getMoisture() {
-    // Return scaled percentage (0-100) based on raw value
-    // Assuming 200 is 0% and 800 is 100% based on simulator logic
-    double percentage = ((moistureLevel - MIN_MOISTURE) / (MAX_MOISTURE - MIN_MOISTURE)) * 100.0;
-    return std::clamp(percentage, 0.0, 100.0);
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return moisturePercent();
 }
 
 double SimulatedHardware::getTemp() {
+    std::lock_guard<std::mutex> lock(stateMutex);
     return temperature;
 }
 
 double SimulatedHardware::getHumid() {
+    std::lock_guard<std::mutex> lock(stateMutex);
     return humidity;
 }
 
 bool SimulatedHardware::isRainDetected() {
+    std::lock_guard<std::mutex> lock(stateMutex);
     return isRaining;
 }
 
 bool SimulatedHardware::isHealthy() {
+    std::lock_guard<std::mutex> lock(stateMutex);
     return systemHealthy;
 }
 
+SensorFrame SimulatedHardware::readAll() {
+    // the whole simulated bus is sampled at one instant
+    std::lock_guard<std::mutex> lock(stateMutex);
+    SensorFrame frame;
+    frame.moisture = moisturePercent();
+    frame.temperature = temperature;
+    frame.humidity = humidity;
+    frame.rainDetected = isRaining;
+    frame.healthy = systemHealthy;
+    frame.timeStamp = clock->now();
+    frame.validate();
+    return frame;
+}
+
 // Pump Interface Implementation
 void SimulatedHardware::activate() {
-    pumpRunning = true;
+    pumpRunning.store(true, std::memory_order_release);
 }
 
 void SimulatedHardware::deactivate() {
-    pumpRunning = false;
+    pumpRunning.store(false, std::memory_order_release);
 }
 
 bool SimulatedHardware::isActive() {
-    return pumpRunning;
+    return pumpRunning.load(std::memory_order_acquire);
 }
 
 void SimulatedHardware::setRain(bool raining, double intensity) {
+    std::lock_guard<std::mutex> lock(stateMutex);
     isRaining = raining;
     rainIntensity = intensity;
 }
 
 void SimulatedHardware::update() {
-    auto now = std::chrono::steady_clock::now();
-    std::chrono::duration<double> distinct = now - lastUpdateTime;
-    double deltaTime = distinct.count();
-    lastUpdateTime = now;
+    PhysicsLog log;
+    bool logDue;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        auto now = clock->now();
+        std::chrono::duration<double> distinct = now - lastUpdateTime;
+        double deltaTime = distinct.count();
+        lastUpdateTime = now;
+
+        logDue = updateSensors(deltaTime, log);
+    }
+    if (logDue) {
+        spdlog::info("PHYSICS: Moisture={:.1f} (Target={:.1f}), Pump={}, Rain={}, Input={:.2f}, Evap={:.2f}, dT={:.3f}",
+            log.moisture, log.target, log.pump, log.rain, log.input, log.evaporation, log.deltaTime);
+    }
+}
+
+double SimulatedHardware::moisturePercent() const {
+    // Return scaled percentage (0-100) based on raw value
+    // Assuming 200 is 0% and 800 is 100% based on simulator logic
+    double percentage = ((moistureLevel - MIN_MOISTURE) / (MAX_MOISTURE - MIN_MOISTURE)) * 100.0;
+    return std::clamp(percentage, 0.0, 100.0);
+}
 
-    updateSensors(deltaTime);
+int SimulatedHardware::currentHourOfDay() {
+    // Wall clock hour at start, advanced by simulated time so virtual days have day/night cycles
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(clock->now() - simStartTime);
+    std::time_t t = wallStartTime + static_cast<std::time_t>(elapsed.count());
+    std::tm local{};
+    localtime_r(&t, &local);
+    return local.tm_hour;
 }
 
-void SimulatedHardware::updateSensors(double deltaTime) {
+bool SimulatedHardware::updateSensors(double deltaTime, PhysicsLog& log) {
     // Get current hour for environmental cycles
-    std::time_t t = std::time(nullptr);
-    std::tm* now = std::localtime(&t);
-    int hourOfDay = now->tm_hour;
+    int hourOfDay = currentHourOfDay();
 
     // Only recalculate temp/humidity if no scenario is active
     if (!scenarioActive) {
@@ -108,8 +154,9 @@ void SimulatedHardware::updateSensors(double deltaTime) {
 
     // Water Input
     double waterInput = 0.0;
+    bool pumping = pumpRunning.load(std::memory_order_acquire);
 
-    if (pumpRunning) {
+    if (pumping) {
         double absorptionRate = 1.0 - std::pow(actualSaturation, 2.0);
         waterInput += 150.0 * absorptionRate * deltaTime; // Boosted pump rate (was 25.0)
     }
@@ -133,18 +180,12 @@ void SimulatedHardware::updateSensors(double deltaTime) {
     moistureLevel += alpha * (actualMoistureLevel - moistureLevel) + noise;
     moistureLevel = std::clamp(moistureLevel, MIN_MOISTURE, MAX_MOISTURE);
 
-    static int logCounter = 0;
-    if (++logCounter >= 200) { // Log every ~20 seconds (assuming 100ms update rate, wait, main loop is 100ms? update() called every loop? yes. so 10 calls/sec. 200 calls = 20s. Maybe too slow? let's do 20 calls = 2s)
-       // Update: use time-based logging
-    }
-    
-    // Better: use static timer
-    static auto lastLog = std::chrono::steady_clock::now();
-    if (std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - lastLog).count() >= 1) {
-        spdlog::info("PHYSICS: Moisture={:.1f} (Target={:.1f}), Pump={}, Rain={}, Input={:.2f}, Evap={:.2f}, dT={:.3f}",
-            moistureLevel, actualMoistureLevel, pumpRunning, isRaining, waterInput, evaporation, deltaTime);
-        lastLog = std::chrono::steady_clock::now();
-    }
+    // Time based logging (once per simulated second, per instance)
+    auto now = clock->now();
+    if (std::chrono::duration_cast<std::chrono::seconds>(now - lastLogTime).count() < 1) return false;
+    log = PhysicsLog{moistureLevel, actualMoistureLevel, pumping, isRaining, waterInput, evaporation, deltaTime};
+    lastLogTime = now;
+    return true;
 }
 
 double SimulatedHardware::calculateTemperature(int hourOfDay) {
@@ -162,7 +203,23 @@ double SimulatedHardware::calculateHumidity(int hourOfDay) {
     return std::clamp(hum, 0.0, 100.0);
 }
 
+void SimulatedHardware::reseed(unsigned seed, int startHour) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    rng.seed(seed);
+    // a wall clock start whose local hour is startHour
+    std::time_t now = std::time(nullptr);
+    std::tm local{};
+    localtime_r(&now, &local);
+    local.tm_hour = startHour;
+    local.tm_min = 0;
+    local.tm_sec = 0;
+    local.tm_isdst = -1;
+    wallStartTime = std::mktime(&local);
+    simStartTime = clock->now();
+}
+
 void SimulatedHardware::setScenario(Scenario scenario) {
+    std::unique_lock<std::mutex> lock(stateMutex);
     scenarioActive = true; // Lock temp/humidity at scenario values
     
     if (scenario == Scenario::DRY) {
@@ -184,14 +241,16 @@ void SimulatedHardware::setScenario(Scenario scenario) {
         temperature = 25.0;
         humidity = 50.0;
         isRaining = false;
-        spdlog::info("SCENARIO: NORMAL APPLIED"); 
     }
-    
+    double moistureSet = moistureLevel;
+    bool locked = scenarioActive;
+    lock.unlock();
+
+    if (scenario == Scenario::NORMAL) spdlog::info("SCENARIO: NORMAL APPLIED");
     if (scenario == Scenario::DRY) spdlog::info("SCENARIO: DRY APPLIED");
     if (scenario == Scenario::WET) spdlog::info("SCENARIO: WET APPLIED");
 
-    // Reset lastUpdateTime to prevent huge time jump if system was idle? 
-    // Actually, update() handles dT based on wall clock. If we warp values, we don't change time.
+    // update() handles dT based on the injected clock. If we warp values, we don't change time.
     // But let's log the post-set values.
-    spdlog::info("SCENARIO RESULT: Moisture set to {}, Scenario Lock: {}", moistureLevel, scenarioActive);
+    spdlog::info("SCENARIO RESULT: Moisture set to {}, Scenario Lock: {}", moistureSet, locked);
 }
@@ -0,0 +1,111 @@
+#include "slope_estimator.hpp"
+#include <algorithm>
+
+namespace {
+    // below this the samples are treated as taken at the same instant / as a flat line
+    constexpr double SPREAD_EPSILON = 1e-9;
+}
+
+SlopeEstimator::SlopeEstimator(std::size_t window)
+    : windowSize(std::max<std::size_t>(MIN_SAMPLES, window)),
+      samples(std::max<std::size_t>(MIN_SAMPLES, window))
+{
+}
+
+void SlopeEstimator::add(TimePoint timeStamp, double moisture)
+{
+    if (filled == 0) origin = timeStamp;
+
+    if (filled == windowSize) {
+        const Sample& evicted = samples[next];
+        double x = secondsSinceOrigin(evicted.timeStamp);
+        sumX -= x;
+        sumY -= evicted.moisture;
+        sumXX -= x * x;
+        sumXY -= x * evicted.moisture;
+        sumYY -= evicted.moisture * evicted.moisture;
+    } else {
+        ++filled;
+    }
+
+    samples[next] = {timeStamp, moisture};
+    next = (next + 1) % windowSize;
+
+    double x = secondsSinceOrigin(timeStamp);
+    sumX += x;
+    sumY += moisture;
+    sumXX += x * x;
+    sumXY += x * moisture;
+    sumYY += moisture * moisture;
+
+    // amortized O(1), keeps x small and drops accumulated rounding error
+    if (++sinceRebase >= windowSize) rebase();
+}
+
+std::optional<double> SlopeEstimator::slope() const
+{
+    if (filled < MIN_SAMPLES) return std::nullopt;
+
+    double n = static_cast<double>(filled);
+    double varX = sumXX - sumX * sumX / n;
+    if (varX <= SPREAD_EPSILON) return std::nullopt;
+
+    double covXY = sumXY - sumX * sumY / n;
+    return covXY / varX * 60.0;
+}
+
+double SlopeEstimator::rSquared() const
+{
+    if (filled < MIN_SAMPLES) return 0.0;
+
+    double n = static_cast<double>(filled);
+    double varX = sumXX - sumX * sumX / n;
+    double varY = sumYY - sumY * sumY / n;
+    if (varX <= SPREAD_EPSILON) return 0.0;
+    // a flat series is fitted exactly by a zero slope
+    if (varY <= SPREAD_EPSILON) return 1.0;
+
+    double covXY = sumXY - sumX * sumY / n;
+    return std::clamp(covXY * covXY / (varX * varY), 0.0, 1.0);
+}
+
+std::size_t SlopeEstimator::count() const
+{
+    return filled;
+}
+
+std::size_t SlopeEstimator::window() const
+{
+    return windowSize;
+}
+
+void SlopeEstimator::reset()
+{
+    next = 0;
+    filled = 0;
+    sinceRebase = 0;
+    sumX = sumY = sumXX = sumXY = sumYY = 0.0;
+}
+
+double SlopeEstimator::secondsSinceOrigin(TimePoint timeStamp) const
+{
+    return std::chrono::duration<double>(timeStamp - origin).count();
+}
+
+void SlopeEstimator::rebase()
+{
+    std::size_t oldest = filled == windowSize ? next : 0;
+    origin = samples[oldest].timeStamp;
+
+    sumX = sumY = sumXX = sumXY = sumYY = 0.0;
+    for (std::size_t i = 0; i < filled; ++i) {
+        const Sample& sample = samples[i];
+        double x = secondsSinceOrigin(sample.timeStamp);
+        sumX += x;
+        sumY += sample.moisture;
+        sumXX += x * x;
+        sumXY += x * sample.moisture;
+        sumYY += sample.moisture * sample.moisture;
+    }
+    sinceRebase = 0;
+}
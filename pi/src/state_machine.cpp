@@ -1,8 +1,14 @@
 #include "state_machine.hpp"
 #include "logger.hpp"
 #include "irrigation_logic.hpp"
-
-std::string StateMachine::stateToString(SystemState state)
+#include "clock.hpp"
+#include "log_timing.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+const char* StateMachine::stateToString(SystemState state)
 {
     switch(state) {
         case SystemState::IDLE: return "IDLE";
@@ -14,7 +20,19 @@ std::string StateMachine::stateToString(SystemState state)
     }
     return "UNKNOWN";
 }
-std::string StateMachine::commandToString(Command cmd)
+const char* StateMachine::phaseToString(TickPhase phase)
+{
+    switch(phase) {
+        case TickPhase::COMMANDS: return "commands";
+        case TickPhase::SENSORS: return "sensors";
+        case TickPhase::LOGIC: return "logic";
+        case TickPhase::ACTUATION: return "actuation";
+        case TickPhase::LOGGING: return "logging";
+        case TickPhase::PUBLISH: return "publish";
+    }
+    return "unknown";
+}
+const char* StateMachine::commandToString(Command cmd)
 {
     switch(cmd) {
         case Command::START_AUTO: return "START_AUTO";
@@ -25,37 +43,74 @@ std::string StateMachine::commandToString(Command cmd)
     return "UNKNOWN";
 }
 
-StateMachine::StateMachine(ISensorInterface* sensor, IPumpInterface* pump, const IrrigationConfig& config)
+StateMachine::StateMachine(ISensorInterface* sensor, IPumpInterface* pump, const IrrigationConfig& config,
+                           IClockInterface* clock)
     :sensor(sensor), pump(pump),
-    config(config),
-    currentState(SystemState::IDLE)
+    clock(clock ? clock : &SteadyClock::instance()),
+    configStore(config),
+    recentReadings(std::max(2, config.historyWindow)),
+    moistureFilter(config.filterKind, std::max(1, config.filterWindow), config.hampelThreshold),
+    moistureTrend(std::max(2, config.slopeWindow)),
+    currentState(SystemState::IDLE),
+    flight(static_cast<std::size_t>(std::max(2, config.flightRecords)))
 {
-    initHandlers();
-    stateEntryTime = std::chrono::steady_clock::now();
+    activeConfig = &configStore.pin().value;
+    stateEntryTime = this->clock->now();
 
     spdlog::info("System started for zone: {}",config.zoneName);
     spdlog::info("Initial state: {}", stateToString(currentState));
     spdlog::info("Soil Type: {}", config.soilType);
     spdlog::info("Thresholds - Low: {}%, High: {}%", config.lowMoistureThreshold, config.highMoistureThreshold);
+    spdlog::info("Moisture filter: {} over {} samples", MoistureFilter::kindToString(config.filterKind), config.filterWindow);
     
-    lastWateringTime = std::chrono::steady_clock::now();
+    lastWateringTime = this->clock->now();
+    publishedState.store(currentState);
+}
+
+// order must follow the SystemState enum
+constexpr std::array<StateMachine::StateHandler, STATE_COUNT> StateMachine::stateHandlers = {
+    &StateMachine::IdleState,       // IDLE
+    &StateMachine::MonitoringState, // MONITORING
+    &StateMachine::WateringState,   // WATERING
+    &StateMachine::WaitingState,    // WAITING
+    &StateMachine::ErrorState,      // ERROR
+    &StateMachine::ManualOverride   // MANUAL
+};
+static_assert(static_cast<std::size_t>(SystemState::MANUAL) + 1 == STATE_COUNT,
+              "stateHandlers must have one entry per SystemState");
+
+bool StateMachine::sendCommnd(Command cmd)
+{
+    // never queued behind other commands or a tick
+    if (cmd == Command::EMERGENCY_STOP) {
+        emergencyStop();
+        return true;
+    }
+    if (!commands.tryPush(cmd)) {
+        spdlog::warn("Command queue full, dropping: {}", commandToString(cmd));
+        return false;
+    }
+    spdlog::debug("Command queued: {}", commandToString(cmd));
+    return true;
 }
 
-void StateMachine::initHandlers()
+void StateMachine::emergencyStop()
 {
-    stateHandlers[SystemState::IDLE]       = &StateMachine::IdleState;
-    stateHandlers[SystemState::MONITORING] = &StateMachine::MonitoringState;
-    stateHandlers[SystemState::WATERING]   = &StateMachine::WateringState;
-    stateHandlers[SystemState::WAITING]    = &StateMachine::WaitingState;
-    stateHandlers[SystemState::ERROR]      = &StateMachine::ErrorState;
-    stateHandlers[SystemState::MANUAL]     = &StateMachine::ManualOverride;
+    // latch before touching the pump, a start racing on the control thread then backs off
+    estopLatched.store(true);
+    pump->deactivate();
+    // no logging here, the watchdog calls this while the logger may be blocked;
+    // update() reports the stop when it takes up the latch
 }
 
-void StateMachine::sendCommnd(Command cmd)
+bool StateMachine::emergencyStopPending() const
 {
-    std::lock_guard<std::mutex> lock(commandMutex);
-    commands.push(cmd);
-    spdlog::debug("Command queued: {}", commandToString(cmd));
+    return estopLatched.load();
+}
+
+bool StateMachine::hasPendingCommands() const
+{
+    return commands.hasPending() || estopLatched.load();
 }
 
 void StateMachine::processCommand(Command cmd)
@@ -71,50 +126,157 @@ void StateMachine::processCommand(Command cmd)
 
         case Command::ENABLE_MANUAL:
             pendingAction = PendingAction::ENTER_MANUAL;
-            pump->activate(); // Activate pump when entering manual mode
+            startPump(); // Activate pump when entering manual mode
             spdlog::warn("MANUAL MODE requested - automatic control disabled, pump activated");
             break;
 
         case Command::DISABLE_MANUAL:
             pendingAction = PendingAction::EXIT_MANUAL;
-            pump->deactivate(); // Deactivate pump when exiting manual mode
+            stopPump(); // Deactivate pump when exiting manual mode
             spdlog::info("Exiting MANUAL mode, pump deactivated");
             break;
 
         case Command::EMERGENCY_STOP:
             pendingAction = PendingAction::EMERGENCY_STOP;
-            spdlog::error("EMERGENCY STOP activated!");
             break;
     }
 }
 SystemState StateMachine::getCurrentState()
 {
-    return this->currentState;
+    return publishedState.load(std::memory_order_acquire);
+}
+void StateMachine::startPump()
+{
+    auto start = std::chrono::steady_clock::now();
+    pump->activate();
+    // an e-stop tripped while switching on wins: either it sees this activate and cuts
+    // it, or this load sees its latch (both sides are sequentially consistent)
+    if (estopLatched.load()) {
+        pump->deactivate();
+        tickPumpFlags |= FlightRecord::PUMP_STOPPED;
+    } else {
+        pumpIsRunning = true;
+        tickPumpFlags |= FlightRecord::PUMP_STARTED;
+    }
+    actuationTime += std::chrono::steady_clock::now() - start;
+}
+void StateMachine::stopPump()
+{
+    auto start = std::chrono::steady_clock::now();
+    pump->deactivate();
+    pumpIsRunning = false;
+    tickPumpFlags |= FlightRecord::PUMP_STOPPED;
+    actuationTime += std::chrono::steady_clock::now() - start;
+}
+void StateMachine::attachAcquisition(SensorAcquisition* acquisition)
+{
+    this->acquisition = acquisition;
+}
+void StateMachine::attachTrace(TraceWriter* trace)
+{
+    this->trace = trace;
+    if (!trace) return;
+    // a replay is constructed from this time and config
+    const auto& snapshot = configStore.pin();
+    activeConfig = &snapshot.value;
+    tracedConfigVersion = snapshot.version;
+    trace->begin(stateEntryTime, snapshot.value);
+}
+StatusSnapshot StateMachine::getStatus() const
+{
+    return status.load();
+}
+void StateMachine::publishStatus(const TickContext& ctx)
+{
+    publishedState.store(currentState, std::memory_order_release);
+
+    StatusSnapshot snapshot;
+    snapshot.state = currentState;
+    snapshot.moisture = currentFrame.moisture;
+    snapshot.filteredMoisture = moistureFilter.value();
+    snapshot.temperature = currentFrame.temperature;
+    snapshot.humidity = currentFrame.humidity;
+    snapshot.pumpActive = pumpIsRunning;
+    snapshot.rainDetected = currentFrame.rainDetected;
+    snapshot.tick = ctx.tick;
+    snapshot.timeStamp = ctx.now;
+    status.store(snapshot);
 }
 IrrigationConfig StateMachine::getConfig() const
 {
-    std::lock_guard<std::mutex> lock(configMutex);
-    return config;
+    return configStore.get();
 }
 void StateMachine::updateConfig(const IrrigationConfig& newconfig)
 {
-    std::lock_guard<std::mutex> lock(configMutex);
-    config = newconfig;
-    spdlog::info("[{}] Configuration updated: {}% - {}%",
-                    config.zoneName,
-                    config.lowMoistureThreshold,
-                    config.highMoistureThreshold);
+    // published as a new snapshot, the control loop picks it up on its next tick
+    std::uint64_t version = configStore.update(newconfig);
+    spdlog::info("[{}] Configuration updated: {}% - {}% (v{})",
+                    newconfig.zoneName,
+                    newconfig.lowMoistureThreshold,
+                    newconfig.highMoistureThreshold,
+                    version);
 }
-void StateMachine::update()
+void StateMachine::pinConfig()
 {
+    const auto& snapshot = configStore.pin();
+    activeConfig = &snapshot.value;
+    if (snapshot.version == appliedConfigVersion) return;
+    appliedConfigVersion = snapshot.version;
+
+    const IrrigationConfig& cfg = snapshot.value;
+    if (recentReadings.capacity() != static_cast<std::size_t>(std::max(2, cfg.historyWindow)))
+        recentReadings.resize(std::max(2, cfg.historyWindow));
+
+    if (moistureFilter.kind() != cfg.filterKind ||
+        moistureFilter.window() != static_cast<std::size_t>(std::max(1, cfg.filterWindow)) ||
+        moistureFilter.outlierThreshold() != cfg.hampelThreshold)
     {
-    std::lock_guard <std::mutex> lock(commandMutex);
-    while (!commands.empty())
+        // rebuild the filter and warm it up from the kept history
+        moistureFilter = MoistureFilter(cfg.filterKind, std::max(1, cfg.filterWindow), cfg.hampelThreshold);
+        for (const auto& reading : recentReadings.view())
+            moistureFilter.add(reading.moisturePercent);
+    }
+    if (moistureTrend.window() != static_cast<std::size_t>(std::max(2, cfg.slopeWindow)))
+        moistureTrend = SlopeEstimator(std::max(2, cfg.slopeWindow));
+}
+void StateMachine::update()
+{
+    auto cpuStart = std::chrono::steady_clock::now();
+    auto logStart = TimedSink::threadTotal();
+    auto busStart = sensorBusTime;
+    auto actuationStart = actuationTime;
+    auto readsStart = sensorReadCount;
+    std::uint8_t flightFlags = 0;
+    unsigned commandCount = 0;
+    tickPumpFlags = 0;
+
+    // one config snapshot per tick, read without locks by every handler
+    pinConfig();
+    const TickContext ctx{clock->now(), ++tickCount, *activeConfig};
+    if (trace) {
+        trace->tick(ctx.now);
+        if (appliedConfigVersion != tracedConfigVersion) {
+            trace->config(ctx.config);
+            tracedConfigVersion = appliedConfigVersion;
+        }
+    }
+
+    // drain without locks, producers are never waited on
+    Command cmd;
+    while (commands.tryPop(cmd))
     {
-        Command cmd = commands.front();
-        commands.pop();
+        if (trace) trace->command(cmd);
         processCommand(cmd);
+        ++commandCount;
     }
+
+    // a tripped e-stop overrides whatever the commands asked for, the pump is already off
+    if (estopLatched.exchange(false)) {
+        spdlog::error("EMERGENCY STOP activated!");
+        pendingAction = PendingAction::EMERGENCY_STOP;
+        pumpIsRunning = false;
+        flightFlags |= FlightRecord::EMERGENCY_STOP;
+        if (trace) trace->emergencyStop();
     }
 
     if (pendingAction != PendingAction::NONE)
@@ -141,70 +303,232 @@ void StateMachine::update()
                 break;
         }
         pendingAction = PendingAction::NONE;
-        stateEntryTime = std::chrono::steady_clock::now();
+        enterState(currentState, ctx.now);
     }
+    auto commandsDone = std::chrono::steady_clock::now();
+    auto commandsLog = TimedSink::threadTotal();
+    auto commandsActuation = actuationTime;
 
-    if (currentState == SystemState::MANUAL)
-    {
-        StateHandler handler = stateHandlers.at(currentState);
-        (this->*handler)();
-
-        publishedState.store(currentState, std::memory_order_relaxed);
+    SystemState tickState = currentState;
+    StateHandler handler = stateHandlers[static_cast<std::size_t>(currentState)];
+    SystemState nextState = (this->*handler)(ctx);
+    ++ticksInState;
 
-        return;
-    }
-
-    auto handler = stateHandlers[currentState];
-
-    SystemState nextState = (this->*handler)();
-
-   if (nextState != currentState) 
+    // MANUAL only leaves through commands
+   if (currentState != SystemState::MANUAL && nextState != currentState) 
     {
-        auto now = std::chrono::steady_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::seconds>(now - stateEntryTime);
+        auto duration = std::chrono::duration_cast<std::chrono::seconds>(ctx.now - stateEntryTime);
         
         spdlog::info("STATE CHANGE: {} to {} (after {}s)", 
                     stateToString(currentState), 
                     stateToString(nextState),
                     duration.count());
                     
-        currentState = nextState;
-        stateEntryTime = std::chrono::steady_clock::now();
+        enterState(nextState, ctx.now);
+    }
+    auto handlerDone = std::chrono::steady_clock::now();
+    auto handlerLog = TimedSink::threadTotal();
+    publishStatus(ctx);
+    if (sensorReadCount != readsStart) {
+        flightFlags |= FlightRecord::SENSOR_READ;
+        if (frameIsFresh) flightFlags |= FlightRecord::FRESH_FRAME;
+    }
+    recordFlight(ctx, tickState, flightFlags, commandCount);
+    auto tickDone = std::chrono::steady_clock::now();
+
+    // split the tick so a slow one can be blamed on a phase
+    auto sensors = sensorBusTime - busStart;
+    lastTiming.state = tickState;
+    lastTiming.tick = ctx.tick;
+    lastTiming.total = tickDone - cpuStart;
+    lastTiming.phase(TickPhase::COMMANDS) = (commandsDone - cpuStart) - (commandsLog - logStart)
+                                            - (commandsActuation - actuationStart);
+    lastTiming.phase(TickPhase::SENSORS) = sensors;
+    lastTiming.phase(TickPhase::LOGIC) = (handlerDone - commandsDone) - sensors - (handlerLog - commandsLog)
+                                         - (actuationTime - commandsActuation);
+    lastTiming.phase(TickPhase::ACTUATION) = actuationTime - actuationStart;
+    lastTiming.phase(TickPhase::LOGGING) = TimedSink::threadTotal() - logStart;
+    lastTiming.phase(TickPhase::PUBLISH) = tickDone - handlerDone;
+
+    recordTick(ctx, tickState, lastTiming.total);
+}
+
+const TickTiming& StateMachine::lastTick() const
+{
+    return lastTiming;
+}
+
+const FlightRecorder& StateMachine::flightRecorder() const
+{
+    return flight;
+}
+
+bool StateMachine::takeErrorDump()
+{
+    return std::exchange(errorDumpPending, false);
+}
+
+void StateMachine::recordFlight(const TickContext& ctx, SystemState state, std::uint8_t flags, unsigned commandCount)
+{
+    FlightRecord entry;
+    entry.tick = ctx.tick;
+    entry.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(ctx.now.time_since_epoch()).count();
+    entry.moisture = currentFrame.moisture;
+    entry.filteredMoisture = moistureFilter.value();
+    entry.changeRate = moistureTrend.slope().value_or(std::numeric_limits<double>::quiet_NaN());
+    entry.configVersion = static_cast<std::uint32_t>(appliedConfigVersion);
+    entry.readFailures = static_cast<std::uint16_t>(std::clamp(consecutiveReadFailures, 0, 0xffff));
+    entry.lowReadings = static_cast<std::uint16_t>(std::clamp(consecutiveLowReadings, 0, 0xffff));
+    entry.state = static_cast<std::uint8_t>(state);
+    entry.nextState = static_cast<std::uint8_t>(currentState);
+    entry.flags = flags | tickPumpFlags | (pumpIsRunning ? FlightRecord::PUMP_RUNNING : 0);
+    entry.commands = static_cast<std::uint8_t>(std::min(commandCount, 0xffu));
+    flight.record(entry);
+    if (trace) trace->decision(currentState, entry.flags & FlightRecord::PUMP_BITS);
+}
+
+void StateMachine::enterState(SystemState state, std::chrono::steady_clock::time_point now)
+{
+    // the file is written outside update(), by whoever polls takeErrorDump()
+    if (state == SystemState::ERROR) errorDumpPending = true;
+    currentState = state;
+    stateEntryTime = now;
+    ticksInState = 0;//restarts the entry burst
+}
+
+void StateMachine::recordTick(const TickContext& ctx, SystemState state, std::chrono::steady_clock::duration cpuTime)
+{
+    if (hasTicked) {
+        // the time since the previous tick was spent in the state that tick left behind
+        std::chrono::duration<double> elapsed = ctx.now - lastTickTime;
+        observedTime += elapsed;
+        baselinePerState[static_cast<std::size_t>(intervalState)] += elapsed / TICK_PERIOD;
+    }
+    lastTickTime = ctx.now;
+    hasTicked = true;
+    intervalState = currentState;
+
+    ++ticksPerState[static_cast<std::size_t>(state)];
+    tickCpuTime += std::chrono::duration_cast<std::chrono::nanoseconds>(cpuTime);
+}
+
+SamplingReport StateMachine::samplingReport() const
+{
+    SamplingReport report;
+    report.observed = observedTime;
+    report.ticks = ticksPerState;
+    report.baselineTicks = baselinePerState;
+    report.sensorReads = sensorReadCount;
+
+    uint64_t ticks = 0;
+    double baseline = 0.0;
+    for (std::size_t i = 0; i < STATE_COUNT; ++i) {
+        ticks += ticksPerState[i];
+        baseline += baselinePerState[i];
+    }
+    if (ticks > 0) report.averageTick = tickCpuTime / ticks;
+    if (sensorReadCount > 0) report.averageSensorRead = sensorBusTime / sensorReadCount;
+    if (observedTime.count() <= 0.0 || ticks == 0) return report;
+
+    // scale what was saved so far to a full day
+    double perDay = std::chrono::duration<double>(std::chrono::hours(24)) / observedTime;
+    double saved = std::max(0.0, baseline - static_cast<double>(ticks));
+    double readsPerTick = static_cast<double>(sensorReadCount) / static_cast<double>(ticks);
+    report.ticksSavedPerDay = saved * perDay;
+    report.cpuSavedPerDay = report.averageTick * saved * perDay;
+    report.busSavedPerDay = report.averageSensorRead * saved * readsPerTick * perDay;
+    return report;
+}
+
+std::chrono::steady_clock::time_point StateMachine::nextDeadline()
+{
+    // fast ticks for the entry burst, then the state's own sampling period
+    const SamplingPolicy& policy = activeConfig->sampling[static_cast<std::size_t>(currentState)];
+    auto period = ticksInState < policy.burstSamples ? TICK_PERIOD
+                                                     : std::max(policy.period, std::chrono::milliseconds(TICK_PERIOD));
+    auto now = clock->now();
+    auto nextTick = now + period;
+
+    switch (currentState)
+    {
+        case SystemState::WAITING:
+        {
+            // nothing changes until the wait period is over, sample at the policy rate after it
+            auto resumeTime = stateEntryTime + std::chrono::minutes(activeConfig->waitMinutes);
+            return resumeTime > now ? std::max(resumeTime, now + TICK_PERIOD) : nextTick;
+        }
+        case SystemState::ERROR:
+        {
+            // recovery is not possible before the recovery interval
+            auto recoveryTime = stateEntryTime + std::chrono::seconds(ERROR_RECOVERY_SECONDS);
+            return recoveryTime > now ? std::max(recoveryTime, now + TICK_PERIOD) : nextTick;
+        }
+        default:
+            return nextTick;
     }
-    publishedState = currentState;
 }
 
-sensorReading StateMachine::createReading(double moisture) {
+sensorReading StateMachine::createReading(const TickContext& ctx, double moisture) {
     return sensorReading{
         moisture,
-        std::chrono::steady_clock::now(),
+        ctx.now,
         IrrigarionLogic::isReadingValid(moisture)
     };
 }
 
-void StateMachine::addSensorReading(double moisture)
+void StateMachine::addSensorReading(const TickContext& ctx, double moisture)
 {
-    std::lock_guard<std::mutex> lock(readingsMutex);
+    // a repeated frame would count the same sample twice in the filters
+    if (!frameIsFresh) return;
+
+    sensorReading reading = createReading(ctx, moisture);
+    recentReadings.push(reading);
+    moistureFilter.add(moisture);
+    if (reading.isValid)
+        moistureTrend.add(reading.timeStamp, moisture);
+}
 
-    recentReadings.push_back(createReading(moisture));
+const SensorFrame& StateMachine::readSensors()
+{
+    // one batched acquisition, handlers call this at most once per tick
+    auto busStart = std::chrono::steady_clock::now();
+    if (acquisition && currentFrame.timeStamp != std::chrono::steady_clock::time_point{}) {
+        // never waits on the bus, keeps the previous frame when nothing new arrived
+        frameIsFresh = acquisition->latest(currentFrame);
+    } else {
+        // inline read, also used until the acquisition thread has delivered a first frame
+        if (!acquisition || !acquisition->latest(currentFrame))
+            currentFrame = sensor->readAll();
+        frameIsFresh = true;
+    }
+    // a late conversion hands back the last good moisture again
+    if (currentFrame.moistureAge.count() > 0) frameIsFresh = false;
+    if (trace) trace->frame(currentFrame, frameIsFresh);
+
+    sensorBusTime += std::chrono::steady_clock::now() - busStart;
+    ++sensorReadCount;
+    return currentFrame;
+}
 
-    if(recentReadings.size() > 10)
-    recentReadings.pop_front();
+double StateMachine::filteredMoisture()
+{
+    return moistureFilter.value();
 }
 
-SystemState StateMachine::IdleState()
+SystemState StateMachine::IdleState(const TickContext& ctx)
 {
     // Perform system health checks
-    double moisture = sensor->getMoisture();
-    double temp = sensor->getTemp();
-    double humid = sensor->getHumid();
-    bool isRaining = sensor->isRainDetected();
-    bool isHealthy = sensor->isHealthy();
+    const SensorFrame& frame = readSensors();
+    double moisture = frame.moisture;
+    double temp = frame.temperature;
+    double humid = frame.humidity;
+    bool isRaining = frame.rainDetected;
+    bool isHealthy = frame.healthy;
     
     (void)temp;    // Will use for temperature-based decisions later
     (void)humid;
-    //Validate all sensor readings
-    if (!isHealthy) {
+    //Validate all sensor readings, a repeated frame is not another failure
+    if (frameIsFresh && !isHealthy) {
         consecutiveReadFailures++;
         spdlog::error("Sensor health check failed in IDLE state (failures: {})", 
                       consecutiveReadFailures);
@@ -213,16 +537,16 @@ SystemState StateMachine::IdleState()
             spdlog::error("Multiple sensor failures - entering ERROR state");
             return SystemState::ERROR;
         }
-    } else {
+    } else if (frameIsFresh) {
         consecutiveReadFailures = 0;  // Reset on successful health check
     }
     
     //Store sensor reading for baseline data
-    addSensorReading(moisture);
+    addSensorReading(ctx, moisture);
     
     // Log system status periodically (every 5 minutes)
     auto idleDuration = std::chrono::duration_cast<std::chrono::seconds>(
-        std::chrono::steady_clock::now() - stateEntryTime
+        ctx.now - stateEntryTime
     );
     
     if (idleDuration.count() % 300 == 0 && idleDuration.count() > 0) {
@@ -233,7 +557,7 @@ SystemState StateMachine::IdleState()
     //Ensure pump is off in IDLE
     if (pump->isActive()) {
         spdlog::warn("Pump was running in IDLE state - stopping for safety");
-        pump->deactivate();
+        stopPump();
     }
     
     // Check environmental conditions
@@ -243,7 +567,6 @@ SystemState StateMachine::IdleState()
     
     // Auto-transition to MONITORING after stability period
     // This allows the system to self-start after initialization
-    auto currentConfig = getConfig();
     if (idleDuration.count() >= 30) {
         // 30 seconds of stable IDLE before auto-starting
         if (isHealthy && !isRaining) {
@@ -254,16 +577,14 @@ SystemState StateMachine::IdleState()
     
     return SystemState::IDLE;
 }
-SystemState StateMachine::MonitoringState()
+SystemState StateMachine::MonitoringState(const TickContext& ctx)
 {
-    double moisture = sensor->getMoisture();
-    addSensorReading(moisture);
-    //get filtered moisture from irrigation logic
-    double filterdMoisture;
-    {
-        std::lock_guard<std::mutex> lock(readingsMutex);
-        filterdMoisture = IrrigarionLogic::getFilteredMoisture(recentReadings);
-    }
+    double moisture = readSensors().moisture;
+    // the debounce counts samples, not ticks, so a repeated frame decides nothing
+    if (!frameIsFresh) return SystemState::MONITORING;
+    addSensorReading(ctx, moisture);
+    //get filtered moisture from the configured filter
+    double filterdMoisture = filteredMoisture();
     //check for invalid reading
     if(!IrrigarionLogic::isReadingValid(moisture))
     {
@@ -280,7 +601,7 @@ SystemState StateMachine::MonitoringState()
     consecutiveReadFailures = 0;
 
     //check for low moisture
-    auto currentConfig = getConfig();
+    const IrrigationConfig& currentConfig = ctx.config;
 
     if (filterdMoisture < currentConfig.lowMoistureThreshold)
     {
@@ -293,7 +614,7 @@ SystemState StateMachine::MonitoringState()
 
     //check logic to decide if watering is needed
     auto timeSinceLastWatering = std::chrono::duration_cast<std::chrono::minutes>(
-        std::chrono::steady_clock::now() - lastWateringTime
+        ctx.now - lastWateringTime
     );
 
     bool shouldWater = IrrigarionLogic::shouldStartWatering(
@@ -306,36 +627,34 @@ SystemState StateMachine::MonitoringState()
 
     if (shouldWater) {
         spdlog::info("Starting watering cycle - Moisture: {}%",filterdMoisture);
-        wateringStartTime = std::chrono::steady_clock::now();
+        wateringStartTime = ctx.now;
+        // the trend only looks at readings taken while the pump runs
+        moistureTrend.reset();
         return SystemState::WATERING;
     }
 
     return SystemState::MONITORING;
 }
-SystemState StateMachine::WateringState()
+SystemState StateMachine::WateringState(const TickContext& ctx)
 {
     if (!pump->isActive())
     {
-        pump->activate();
+        startPump();
         spdlog::info("pump started");
     }
     
     //get moisture 
-    double moisture = sensor->getMoisture();
-    addSensorReading(moisture);
+    double moisture = readSensors().moisture;
+    addSensorReading(ctx, moisture);
     //get filtered readings
-    double filteredMoisture;
-    std::optional<double> changeRate;
-    {
-        std::lock_guard<std::mutex> lock(readingsMutex);
-        filteredMoisture = IrrigarionLogic::getFilteredMoisture(recentReadings);
-        changeRate = IrrigarionLogic::getMoistuerChangeRate(recentReadings);
-    }
+    double filteredMoisture = moistureFilter.value();
+    std::optional<double> changeRate = moistureTrend.slope();
+    double trendFit = moistureTrend.rSquared();
     //calculate watering duration
     auto wateringDuration = std::chrono::duration_cast<std::chrono::seconds> (
-        std::chrono::steady_clock::now() - wateringStartTime
+        ctx.now - wateringStartTime
     );
-    auto currentConfig = getConfig();
+    const IrrigationConfig& currentConfig = ctx.config;
     //check if we should stop watering 
     bool shouldStop = IrrigarionLogic::shouldStopWatering(
         filteredMoisture,
@@ -347,8 +666,8 @@ SystemState StateMachine::WateringState()
 
     if(shouldStop)
     {
-        pump->deactivate();
-        lastWateringTime = std::chrono::steady_clock::now();
+        stopPump();
+        lastWateringTime = ctx.now;
         if (filteredMoisture >= currentConfig.highMoistureThreshold)
         {
             spdlog::info("Target moisture reached: {}%", filteredMoisture);
@@ -359,7 +678,8 @@ SystemState StateMachine::WateringState()
             return SystemState::ERROR;
         }
         else if (changeRate.has_value() && changeRate.value() < 0.5) {
-            spdlog::error("Moisture not increasing - possible pump failure");
+            spdlog::error("Moisture not increasing ({:.2f}%/min, r2 {:.2f}) - possible pump failure",
+                          changeRate.value(), trendFit);
             return SystemState::ERROR;
         }
     return SystemState::WAITING;
@@ -373,15 +693,15 @@ SystemState StateMachine::WateringState()
     return SystemState::WATERING;
 }
 
-SystemState StateMachine::WaitingState()
+SystemState StateMachine::WaitingState(const TickContext& ctx)
 {
     //calculate waite time
     auto waitDuration = std::chrono::duration_cast<std::chrono::minutes>(
-        std::chrono::steady_clock::now() - stateEntryTime
+        ctx.now - stateEntryTime
     );
 
     //check if wait period is complete 
-    auto currentConfig = getConfig();
+    const IrrigationConfig& currentConfig = ctx.config;
     bool shouldResume = IrrigarionLogic::shouldResumeMonitoring(
         waitDuration,
         currentConfig.waitMinutes
@@ -402,29 +722,26 @@ SystemState StateMachine::WaitingState()
     }
     return SystemState::WAITING;
 }
-SystemState StateMachine::ErrorState()
+SystemState StateMachine::ErrorState(const TickContext& ctx)
 {
     //stop pump
     if(pump->isActive())
     {
-        pump->deactivate();
+        stopPump();
         spdlog::error("Emergency pump shutdown, an error occured");
     }
     //calculate Error duration
     auto errorDuration = std::chrono::duration_cast<std::chrono::seconds>(
-        std::chrono::steady_clock::now() - stateEntryTime
+        ctx.now - stateEntryTime
     );
     //check if we can recover
-    double moisture = sensor->getMoisture();
+    double moisture = readSensors().moisture;
     bool lastReadingValid = IrrigarionLogic::isReadingValid(moisture);
     
-    auto currentConfig = getConfig();
-    int recoveryIntervalSeconds = 300;  // 5 minutes 
-    
     bool canRecover = IrrigarionLogic::canRecoverFromError(
         consecutiveReadFailures,
         errorDuration,
-        recoveryIntervalSeconds,
+        ERROR_RECOVERY_SECONDS,
         lastReadingValid
     );
     
@@ -445,12 +762,13 @@ SystemState StateMachine::ErrorState()
     
     return SystemState::ERROR;
 }
-SystemState StateMachine::ManualOverride()
+SystemState StateMachine::ManualOverride(const TickContext& ctx)
 {
     //Read current sensor state for monitoring
-    double moisture = sensor->getMoisture();
-    double temp = sensor->getTemp();
-    bool isHealthy = sensor->isHealthy();
+    const SensorFrame& frame = readSensors();
+    double moisture = frame.moisture;
+    double temp = frame.temperature;
+    bool isHealthy = frame.healthy;
     
     (void)temp;   
    
@@ -460,17 +778,17 @@ SystemState StateMachine::ManualOverride()
         
         // Safety: Stop pump if sensors fail
         if (pump->isActive()) {
-            pump->deactivate();
+            stopPump();
             spdlog::warn("Pump stopped due to sensor failure in MANUAL mode");
         }
     }
     
     //Store readings for continuity when returning to AUTO
-    addSensorReading(moisture);
+    addSensorReading(ctx, moisture);
     
     //Log manual operation status periodically
     auto manualDuration = std::chrono::duration_cast<std::chrono::seconds>(
-        std::chrono::steady_clock::now() - stateEntryTime
+        ctx.now - stateEntryTime
     );
     
     if (manualDuration.count() % 60 == 0 && manualDuration.count() > 0) {
@@ -481,20 +799,19 @@ SystemState StateMachine::ManualOverride()
     }
     
     // Safety timeout - prevent indefinite manual watering
-    auto currentConfig = getConfig();
     int manualTimeoutSeconds = 3600;  //(1 hour)
     
     if (pump->isActive() && manualDuration.count() >= manualTimeoutSeconds) {
         spdlog::warn("Manual watering timeout exceeded ({}s) - stopping pump for safety",
                      manualTimeoutSeconds);
-        pump->deactivate();
+        stopPump();
     }
     
     //Emergency moisture limit - prevent over-watering
     if (pump->isActive() && moisture >= 95.0) {
         spdlog::error("Critical moisture level reached ({}%) - emergency pump stop",
                       moisture);
-        pump->deactivate();
+        stopPump();
     }
     
     //Check for excessive manual duration without pump activity
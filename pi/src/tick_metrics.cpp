@@ -0,0 +1,60 @@
+#include "tick_metrics.hpp"
+
+namespace {
+
+std::string percentilesJson(const LatencyHistogram& histogram)
+{
+    return "\"p50_ns\":" + std::to_string(histogram.percentile(50).count()) +
+           ",\"p99_ns\":" + std::to_string(histogram.percentile(99).count()) +
+           ",\"max_ns\":" + std::to_string(histogram.max().count());
+}
+
+}
+
+void TickMetrics::record(const TickTiming& timing)
+{
+    auto state = static_cast<std::size_t>(timing.state);
+    totals[state].record(timing.total);
+    for (std::size_t p = 0; p < TICK_PHASE_COUNT; ++p)
+        phases[state][p].record(timing.phases[p]);
+}
+
+void TickMetrics::reset()
+{
+    for (auto& histogram : totals) histogram.reset();
+    for (auto& perState : phases)
+        for (auto& histogram : perState) histogram.reset();
+}
+
+const LatencyHistogram& TickMetrics::total(SystemState state) const
+{
+    return totals[static_cast<std::size_t>(state)];
+}
+
+const LatencyHistogram& TickMetrics::phase(SystemState state, TickPhase phase) const
+{
+    return phases[static_cast<std::size_t>(state)][static_cast<std::size_t>(phase)];
+}
+
+std::string TickMetrics::summaryJson() const
+{
+    std::string json = "{\"states\":{";
+    bool first = true;
+    for (std::size_t s = 0; s < STATE_COUNT; ++s) {
+        if (totals[s].count() == 0) continue;
+        if (!first) json += ",";
+        first = false;
+
+        json += std::string("\"") + StateMachine::stateToString(static_cast<SystemState>(s)) + "\":{";
+        json += "\"count\":" + std::to_string(totals[s].count()) + "," + percentilesJson(totals[s]);
+        json += ",\"phases\":{";
+        for (std::size_t p = 0; p < TICK_PHASE_COUNT; ++p) {
+            if (p > 0) json += ",";
+            json += std::string("\"") + StateMachine::phaseToString(static_cast<TickPhase>(p)) + "\":{" +
+                    percentilesJson(phases[s][p]) + "}";
+        }
+        json += "}}";
+    }
+    json += "}}";
+    return json;
+}
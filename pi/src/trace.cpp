@@ -0,0 +1,461 @@
+#include "trace.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+constexpr char MAGIC[4] = {'I', 'R', 'T', 'R'};
+constexpr std::uint16_t VERSION = 1;
+constexpr std::size_t HEADER_BYTES = 8;
+constexpr std::size_t MAX_STRING = 255;
+constexpr std::size_t MAX_EVENT = 1024;//largest encoded event, a config with two full strings
+
+// frame flag bits
+constexpr std::uint8_t RAIN = 1 << 0;
+constexpr std::uint8_t HEALTHY = 1 << 1;
+constexpr std::uint8_t MOISTURE_VALID = 1 << 2;
+constexpr std::uint8_t TEMPERATURE_VALID = 1 << 3;
+constexpr std::uint8_t HUMIDITY_VALID = 1 << 4;
+constexpr std::uint8_t FRESH = 1 << 5;
+
+std::int64_t toNs(std::chrono::steady_clock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::steady_clock::time_point fromNs(std::int64_t ns)
+{
+    return std::chrono::steady_clock::time_point(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(ns)));
+}
+
+void putVarint(std::uint8_t*& out, std::uint64_t value)
+{
+    while (value >= 0x80) {
+        *out++ = static_cast<std::uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<std::uint8_t>(value);
+}
+
+void putSigned(std::uint8_t*& out, std::int64_t value)
+{
+    putVarint(out, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+void putDouble(std::uint8_t*& out, double value)
+{
+    std::memcpy(out, &value, sizeof(value));
+    out += sizeof(value);
+}
+
+void putString(std::uint8_t*& out, const std::string& text)
+{
+    std::size_t length = std::min(text.size(), MAX_STRING);
+    putVarint(out, length);
+    std::memcpy(out, text.data(), length);
+    out += length;
+}
+
+void putConfig(std::uint8_t*& out, const IrrigationConfig& config)
+{
+    putString(out, config.zoneName);
+    putString(out, config.soilType);
+    putDouble(out, config.lowMoistureThreshold);
+    putDouble(out, config.highMoistureThreshold);
+    putSigned(out, config.maxWateringSeconds);
+    putSigned(out, config.waitMinutes);
+    putSigned(out, config.minWateringIntervalMinutes);
+    putSigned(out, config.historyWindow);
+    *out++ = static_cast<std::uint8_t>(config.filterKind);
+    putSigned(out, config.filterWindow);
+    putDouble(out, config.hampelThreshold);
+    putSigned(out, config.slopeWindow);
+    for (const SamplingPolicy& policy : config.sampling) {
+        putSigned(out, policy.period.count());
+        putSigned(out, policy.burstSamples);
+    }
+}
+
+// bounds checked reads, every getter returns false past the end
+class Cursor
+{
+    public:
+        Cursor(std::span<const std::uint8_t> data, std::size_t& offset) : data(data), offset(offset) {}
+
+        bool byte(std::uint8_t& value)
+        {
+            if (offset >= data.size()) return false;
+            value = data[offset++];
+            return true;
+        }
+
+        bool varint(std::uint64_t& value)
+        {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                std::uint8_t b;
+                if (!byte(b)) return false;
+                value |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+                if ((b & 0x80) == 0) return true;
+            }
+            return false;
+        }
+
+        bool signedVarint(std::int64_t& value)
+        {
+            std::uint64_t raw;
+            if (!varint(raw)) return false;
+            value = static_cast<std::int64_t>(raw >> 1) ^ -static_cast<std::int64_t>(raw & 1);
+            return true;
+        }
+
+        template <typename Int>
+        bool integer(Int& value)
+        {
+            std::int64_t raw;
+            if (!signedVarint(raw)) return false;
+            value = static_cast<Int>(raw);
+            return true;
+        }
+
+        bool real(double& value)
+        {
+            if (data.size() - offset < sizeof(value)) return false;
+            std::memcpy(&value, data.data() + offset, sizeof(value));
+            offset += sizeof(value);
+            return true;
+        }
+
+        bool text(std::string& value)
+        {
+            std::uint64_t length;
+            if (!varint(length) || length > data.size() - offset) return false;
+            value.assign(reinterpret_cast<const char*>(data.data() + offset), length);
+            offset += length;
+            return true;
+        }
+
+        bool config(IrrigationConfig& config)
+        {
+            std::uint8_t kind;
+            bool ok = text(config.zoneName) && text(config.soilType) &&
+                      real(config.lowMoistureThreshold) && real(config.highMoistureThreshold) &&
+                      integer(config.maxWateringSeconds) && integer(config.waitMinutes) &&
+                      integer(config.minWateringIntervalMinutes) && integer(config.historyWindow) &&
+                      byte(kind) && integer(config.filterWindow) && real(config.hampelThreshold) &&
+                      integer(config.slopeWindow);
+            if (!ok) return false;
+            config.filterKind = static_cast<FilterKind>(kind);
+            for (SamplingPolicy& policy : config.sampling) {
+                std::int64_t period;
+                if (!signedVarint(period) || !integer(policy.burstSamples)) return false;
+                policy.period = std::chrono::milliseconds(period);
+            }
+            return true;
+        }
+
+    private:
+        std::span<const std::uint8_t> data;
+        std::size_t& offset;
+};
+
+}
+
+TraceWriter::TraceWriter(const std::string& path, std::size_t chunkBytes, std::size_t chunkCount)
+{
+    chunkBytes = std::max(chunkBytes, 4 * MAX_EVENT);
+    chunkCount = std::clamp<std::size_t>(chunkCount, 2, MAX_CHUNKS);
+    chunks.assign(chunkCount, std::vector<std::uint8_t>(chunkBytes));
+    for (std::uint32_t i = 0; i < chunkCount; ++i) freeChunks.tryPush(i);
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        spdlog::error("Trace: cannot open {}", path);
+        return;
+    }
+    std::uint8_t header[HEADER_BYTES] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    std::memcpy(header + sizeof(MAGIC), &VERSION, sizeof(VERSION));
+    std::fwrite(header, 1, sizeof(header), file);
+    written = sizeof(header);
+    worker = std::thread(&TraceWriter::run, this);
+}
+
+TraceWriter::~TraceWriter()
+{
+    close();
+}
+
+bool TraceWriter::isOpen() const
+{
+    return file != nullptr;
+}
+
+void TraceWriter::close()
+{
+    if (!file) return;
+    if (current >= 0 && used[static_cast<std::size_t>(current)] > 0) handOff();
+    stopping = true;
+    wake.notify_one();
+    if (worker.joinable()) worker.join();
+    std::fclose(file);
+    file = nullptr;
+    if (dropped.load() > 0) spdlog::warn("Trace: {} events dropped, the trace has gaps", dropped.load());
+}
+
+std::uint8_t* TraceWriter::reserve(std::size_t bytes)
+{
+    if (!file) return nullptr;
+    if (current >= 0 && used[static_cast<std::size_t>(current)] + bytes > chunks[0].size()) handOff();
+    if (current < 0) {
+        std::uint32_t next;
+        if (!freeChunks.tryPop(next)) {
+            ++lost;
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        current = next;
+        used[next] = 0;
+        if (lost > 0) {
+            // the reader stops here, what follows cannot be replayed deterministically
+            std::uint8_t* out = chunks[next].data();
+            *out++ = static_cast<std::uint8_t>(TraceEventType::GAP);
+            putVarint(out, lost);
+            used[next] = static_cast<std::size_t>(out - chunks[next].data());
+            lost = 0;
+        }
+    }
+    return chunks[static_cast<std::size_t>(current)].data() + used[static_cast<std::size_t>(current)];
+}
+
+void TraceWriter::handOff()
+{
+    fullChunks.tryPush(static_cast<std::uint32_t>(current));//never full, it holds every chunk
+    current = -1;
+    wake.notify_one();
+}
+
+void TraceWriter::run()
+{
+    while (true) {
+        bool stop = stopping.load();
+        std::uint32_t index;
+        while (fullChunks.tryPop(index)) {
+            std::fwrite(chunks[index].data(), 1, used[index], file);
+            written.fetch_add(used[index], std::memory_order_relaxed);
+            freeChunks.tryPush(index);
+        }
+        if (stop) break;
+        // notify without the mutex can be missed, the timeout bounds the delay
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait_for(lock, std::chrono::milliseconds(50));
+    }
+    std::fflush(file);
+}
+
+void TraceWriter::commit(const std::uint8_t* end)
+{
+    auto index = static_cast<std::size_t>(current);
+    used[index] = static_cast<std::size_t>(end - chunks[index].data());
+}
+
+void TraceWriter::begin(std::chrono::steady_clock::time_point start, const IrrigationConfig& config)
+{
+    std::uint8_t* out = reserve(MAX_EVENT);
+    if (!out) return;
+    *out++ = static_cast<std::uint8_t>(TraceEventType::BEGIN);
+    lastTickNs = toNs(start);
+    putSigned(out, lastTickNs);
+    putConfig(out, config);
+    commit(out);
+}
+
+void TraceWriter::tick(std::chrono::steady_clock::time_point now)
+{
+    std::uint8_t* out = reserve(16);
+    if (!out) return;
+    *out++ = static_cast<std::uint8_t>(TraceEventType::TICK);
+    std::int64_t ns = toNs(now);
+    putSigned(out, ns - lastTickNs);
+    lastTickNs = ns;
+    commit(out);
+}
+
+void TraceWriter::config(const IrrigationConfig& config)
+{
+    std::uint8_t* out = reserve(MAX_EVENT);
+    if (!out) return;
+    *out++ = static_cast<std::uint8_t>(TraceEventType::CONFIG);
+    putConfig(out, config);
+    commit(out);
+}
+
+void TraceWriter::command(Command cmd)
+{
+    std::uint8_t* out = reserve(2);
+    if (!out) return;
+    *out++ = static_cast<std::uint8_t>(TraceEventType::COMMAND);
+    *out++ = static_cast<std::uint8_t>(cmd);
+    commit(out);
+}
+
+void TraceWriter::emergencyStop()
+{
+    std::uint8_t* out = reserve(1);
+    if (!out) return;
+    *out++ = static_cast<std::uint8_t>(TraceEventType::EMERGENCY_STOP);
+    commit(out);
+}
+
+void TraceWriter::frame(const SensorFrame& frame, bool fresh)
+{
+    std::uint8_t* out = reserve(64);
+    if (!out) return;
+    *out++ = static_cast<std::uint8_t>(TraceEventType::FRAME);
+    *out++ = static_cast<std::uint8_t>((frame.rainDetected ? RAIN : 0) | (frame.healthy ? HEALTHY : 0) |
+                                       (frame.moistureValid ? MOISTURE_VALID : 0) |
+                                       (frame.temperatureValid ? TEMPERATURE_VALID : 0) |
+                                       (frame.humidityValid ? HUMIDITY_VALID : 0) | (fresh ? FRESH : 0));
+    putDouble(out, frame.moisture);
+    putDouble(out, frame.temperature);
+    putDouble(out, frame.humidity);
+    putSigned(out, toNs(frame.timeStamp) - lastTickNs);
+    putSigned(out, frame.moistureAge.count());
+    putSigned(out, frame.temperatureAge.count());
+    putSigned(out, frame.humidityAge.count());
+    commit(out);
+}
+
+void TraceWriter::decision(SystemState state, std::uint8_t pumpFlags)
+{
+    std::uint8_t* out = reserve(3);
+    if (!out) return;
+    *out++ = static_cast<std::uint8_t>(TraceEventType::DECISION);
+    *out++ = static_cast<std::uint8_t>(state);
+    *out++ = pumpFlags;
+    commit(out);
+}
+
+std::uint64_t TraceWriter::bytesWritten() const
+{
+    return written.load(std::memory_order_relaxed);
+}
+
+std::uint64_t TraceWriter::droppedEvents() const
+{
+    return dropped.load(std::memory_order_relaxed);
+}
+
+TraceReader::TraceReader(std::span<const std::uint8_t> bytes)
+    : data(bytes)
+{
+    std::uint16_t version = 0;
+    if (data.size() >= HEADER_BYTES) std::memcpy(&version, data.data() + sizeof(MAGIC), sizeof(version));
+    headerOk = data.size() >= HEADER_BYTES && std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0 &&
+               version == VERSION;
+    offset = HEADER_BYTES;
+}
+
+bool TraceReader::load(const std::string& path, std::vector<std::uint8_t>& bytes)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool TraceReader::valid() const
+{
+    return headerOk;
+}
+
+bool TraceReader::truncated() const
+{
+    return cut;
+}
+
+bool TraceReader::next(TraceEvent& event)
+{
+    if (!headerOk || cut || offset >= data.size()) return false;
+
+    std::size_t start = offset;
+    Cursor in(data, offset);
+    std::uint8_t type = 0;
+    in.byte(type);
+    event.type = static_cast<TraceEventType>(type);
+
+    bool ok = false;
+    switch (event.type) {
+        case TraceEventType::BEGIN:
+        {
+            ok = in.signedVarint(lastTickNs) && in.config(event.config);
+            event.time = fromNs(lastTickNs);
+            break;
+        }
+        case TraceEventType::TICK:
+        {
+            std::int64_t delta = 0;
+            ok = in.signedVarint(delta);
+            lastTickNs += delta;
+            event.time = fromNs(lastTickNs);
+            break;
+        }
+        case TraceEventType::CONFIG:
+            ok = in.config(event.config);
+            break;
+        case TraceEventType::COMMAND:
+        {
+            std::uint8_t cmd = 0;
+            ok = in.byte(cmd);
+            event.command = static_cast<Command>(cmd);
+            break;
+        }
+        case TraceEventType::EMERGENCY_STOP:
+            ok = true;
+            break;
+        case TraceEventType::FRAME:
+        {
+            std::uint8_t flags = 0;
+            std::int64_t stamp = 0;
+            std::int64_t moistureAge = 0;
+            std::int64_t temperatureAge = 0;
+            std::int64_t humidityAge = 0;
+            SensorFrame& frame = event.frame;
+            ok = in.byte(flags) && in.real(frame.moisture) && in.real(frame.temperature) &&
+                 in.real(frame.humidity) && in.signedVarint(stamp) && in.signedVarint(moistureAge) &&
+                 in.signedVarint(temperatureAge) && in.signedVarint(humidityAge);
+            frame.rainDetected = flags & RAIN;
+            frame.healthy = flags & HEALTHY;
+            frame.moistureValid = flags & MOISTURE_VALID;
+            frame.temperatureValid = flags & TEMPERATURE_VALID;
+            frame.humidityValid = flags & HUMIDITY_VALID;
+            frame.timeStamp = fromNs(lastTickNs + stamp);
+            frame.moistureAge = std::chrono::microseconds(moistureAge);
+            frame.temperatureAge = std::chrono::microseconds(temperatureAge);
+            frame.humidityAge = std::chrono::microseconds(humidityAge);
+            event.fresh = flags & FRESH;
+            break;
+        }
+        case TraceEventType::DECISION:
+        {
+            std::uint8_t state = 0;
+            ok = in.byte(state) && in.byte(event.pumpFlags) && state < STATE_COUNT;
+            event.state = static_cast<SystemState>(state);
+            break;
+        }
+        case TraceEventType::GAP:
+            ok = in.varint(event.lost);
+            break;
+    }
+    if (!ok) {
+        // unknown type or an event cut off at the end of the file
+        offset = start;
+        cut = true;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,156 @@
+#include "trace_replay.hpp"
+#include "clock.hpp"
+#include <vector>
+
+namespace {
+
+// Hands out the frames recorded for the tick being replayed, in order
+class ReplaySensor : public ISensorInterface
+{
+    public:
+        void push(const SensorFrame& frame, bool fresh)
+        {
+            SensorFrame next = frame;
+            // a repeated frame reaches the machine as a reused value, so it is not sampled twice
+            if (!fresh && next.moistureAge.count() == 0) next.moistureAge = std::chrono::microseconds(1);
+            frames.push_back(next);
+        }
+
+        // frames left over from the tick just replayed
+        std::size_t discard()
+        {
+            std::size_t left = frames.size() - next;
+            frames.clear();
+            next = 0;
+            return left;
+        }
+
+        std::uint64_t missing = 0;
+
+        bool initialize() override { return true; }
+        double getMoisture() override { return last.moisture; }
+        double getTemp() override { return last.temperature; }
+        double getHumid() override { return last.humidity; }
+        bool isRainDetected() override { return last.rainDetected; }
+        bool isHealthy() override { return last.healthy; }
+        SensorFrame readAll() override
+        {
+            if (next < frames.size()) {
+                last = frames[next++];
+            } else {
+                // the replay read where the recording did not, repeat the last frame
+                ++missing;
+                last.moistureAge = std::chrono::microseconds(1);
+            }
+            return last;
+        }
+
+    private:
+        std::vector<SensorFrame> frames;
+        std::size_t next = 0;
+        SensorFrame last;
+};
+
+class ReplayPump : public IPumpInterface
+{
+    public:
+        bool initialize() override { return true; }
+        void activate() override { running = true; }
+        void deactivate() override { running = false; }
+        bool isActive() override { return running; }
+
+    private:
+        bool running = false;
+};
+
+}
+
+ReplayResult TraceReplay::run(std::span<const std::uint8_t> bytes, const TickObserver& observer)
+{
+    auto wallStart = std::chrono::steady_clock::now();
+    ReplayResult result;
+
+    TraceReader reader(bytes);
+    TraceEvent event;
+    if (!reader.next(event) || event.type != TraceEventType::BEGIN) return result;
+
+    const auto start = event.time;
+    VirtualClock clock(start);
+    ReplaySensor sensor;
+    ReplayPump pump;
+    StateMachine machine(&sensor, &pump, event.config, &clock);
+
+    bool tickPending = false;
+    bool haveDecision = false;
+    std::chrono::steady_clock::time_point tickTime = start;
+    TraceEvent recorded;
+
+    // runs the tick whose inputs have all been queued
+    auto replayTick = [&]() {
+        if (!tickPending) return;
+        tickPending = false;
+        SystemState before = machine.getCurrentState();
+        clock.set(tickTime);
+        machine.update();
+        result.unusedFrames += sensor.discard();
+
+        FlightRecord entry;
+        machine.flightRecorder().latest(entry);
+        ++result.ticks;
+        ++result.ticksPerState[entry.state];
+        if (machine.getCurrentState() != before) ++result.transitions;
+        if (entry.flags & FlightRecord::PUMP_STARTED) ++result.pumpStarts;
+        if (haveDecision && (static_cast<SystemState>(entry.nextState) != recorded.state ||
+                             (entry.flags & FlightRecord::PUMP_BITS) != recorded.pumpFlags)) {
+            ++result.divergences;
+            if (result.firstDivergence == 0) result.firstDivergence = entry.tick;
+        }
+        haveDecision = false;
+        if (observer) observer(machine);
+    };
+
+    bool gap = false;
+    while (!gap && reader.next(event)) {
+        switch (event.type) {
+            case TraceEventType::TICK:
+                replayTick();
+                tickPending = true;
+                tickTime = event.time;
+                break;
+            case TraceEventType::CONFIG:
+                machine.updateConfig(event.config);
+                ++result.configChanges;
+                break;
+            case TraceEventType::COMMAND:
+                machine.sendCommnd(event.command);
+                ++result.commands;
+                break;
+            case TraceEventType::EMERGENCY_STOP:
+                machine.emergencyStop();
+                ++result.emergencyStops;
+                break;
+            case TraceEventType::FRAME:
+                sensor.push(event.frame, event.fresh);
+                ++result.frames;
+                break;
+            case TraceEventType::DECISION:
+                recorded.state = event.state;
+                recorded.pumpFlags = event.pumpFlags;
+                haveDecision = true;
+                break;
+            case TraceEventType::GAP:
+            case TraceEventType::BEGIN:
+                // nothing after a hole can be replayed faithfully
+                gap = true;
+                break;
+        }
+    }
+    // the last tick only counts when its decision made it into the trace
+    if (haveDecision) replayTick();
+
+    result.missingFrames = sensor.missing;
+    result.complete = !gap && !reader.truncated();
+    result.simulated = tickTime - start;
+    result.elapsed = std::chrono::steady_clock::now() - wallStart;
+    return result;
+}
@@ -0,0 +1,131 @@
+#include "zone_executor.hpp"
+#include <algorithm>
+
+ZoneExecutor::ZoneExecutor(std::size_t threadCount)
+    : queues(std::make_unique<WorkQueue[]>(std::max<std::size_t>(1, threadCount))),
+      workerCount(std::max<std::size_t>(1, threadCount))
+{
+    for (std::size_t i = 1; i < workerCount; ++i)
+        workers.emplace_back(&ZoneExecutor::workerLoop, this, i);
+}
+
+ZoneExecutor::~ZoneExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(batchMutex);
+        stopping = true;
+    }
+    batchReady.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+}
+
+std::size_t ZoneExecutor::threadCount() const
+{
+    return workerCount;
+}
+
+uint64_t ZoneExecutor::stealCount() const
+{
+    return steals.load(std::memory_order_relaxed);
+}
+
+void ZoneExecutor::parallelFor(std::size_t taskCount, const TaskBody& taskBody)
+{
+    if (taskCount == 0) return;
+
+    remaining.store(taskCount, std::memory_order_relaxed);
+
+    // Even split up front, stealing evens out zones that take longer.
+    // No worker is inside runTasks here, the last batch waited for all of them.
+    for (std::size_t w = 0; w < workerCount; ++w) {
+        std::lock_guard<std::mutex> lock(queues[w].mutex);
+        queues[w].begin = taskCount * w / workerCount;
+        queues[w].end = taskCount * (w + 1) / workerCount;
+    }
+
+    {
+        // body and the queues are published to the workers by the generation change
+        std::lock_guard<std::mutex> lock(batchMutex);
+        body = &taskBody;
+        batchOpen = true;
+        ++generation;
+    }
+    if (workerCount > 1) batchReady.notify_all();
+
+    runTasks(0);
+
+    std::unique_lock<std::mutex> lock(batchMutex);
+    batchDone.wait(lock, [this]() { return remaining.load(std::memory_order_acquire) == 0; });
+    // Late workers skip this batch, the ones still stealing are waited for
+    batchOpen = false;
+    batchDone.wait(lock, [this]() { return activeWorkers == 0; });
+    body = nullptr;
+}
+
+void ZoneExecutor::workerLoop(std::size_t self)
+{
+    uint64_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(batchMutex);
+            batchReady.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+            if (!batchOpen) continue;
+            ++activeWorkers;
+        }
+        runTasks(self);
+        {
+            std::lock_guard<std::mutex> lock(batchMutex);
+            if (--activeWorkers == 0) batchDone.notify_all();
+        }
+    }
+}
+
+void ZoneExecutor::runTasks(std::size_t self)
+{
+    std::size_t task;
+    while (popLocal(self, task) || (steal(self) && popLocal(self, task))) {
+        (*body)(task);
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // last task of the batch, wake the caller
+            std::lock_guard<std::mutex> lock(batchMutex);
+            batchDone.notify_all();
+        }
+    }
+}
+
+bool ZoneExecutor::popLocal(std::size_t self, std::size_t& task)
+{
+    WorkQueue& queue = queues[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.begin == queue.end) return false;
+    task = queue.begin++;
+    return true;
+}
+
+bool ZoneExecutor::steal(std::size_t self)
+{
+    for (std::size_t offset = 1; offset < workerCount; ++offset) {
+        WorkQueue& victim = queues[(self + offset) % workerCount];
+        std::size_t begin, end;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            std::size_t available = victim.end - victim.begin;
+            if (available == 0) continue;
+            // take the back half, the victim keeps working from the front
+            end = victim.end;
+            begin = end - (available + 1) / 2;
+            victim.end = begin;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queues[self].mutex);
+            queues[self].begin = begin;
+            queues[self].end = end;
+        }
+        steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
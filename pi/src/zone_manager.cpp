@@ -0,0 +1,206 @@
+#include "zone_manager.hpp"
+#include "logger.hpp"
+#include "clock.hpp"
+#include <algorithm>
+#include <charconv>
+#include <map>
+
+namespace {
+    const std::string SITE_COMMAND_TOPIC = "irrigation/command";
+    const std::string SITE_STATUS_TOPIC = "irrigation/status";
+    const std::string ZONE_TOPIC_PREFIX = "irrigation/zones/";
+    const std::string COMMAND_SUFFIX = "/command";
+}
+
+ZoneManager::ZoneManager(IClockInterface* clock)
+    : clock(clock ? clock : &SteadyClock::instance())
+{
+}
+
+ZoneManager::ZoneId ZoneManager::addZone(const IrrigationConfig& config, ISensorInterface* sensor, IPumpInterface* pump,
+                                         std::optional<int> busId)
+{
+    zones.push_back(Zone{
+        sensor,
+        pump,
+        busId,
+        std::make_unique<StateMachine>(sensor, pump, config, clock)
+    });
+    shardsDirty = true;
+    return zones.size() - 1;
+}
+
+std::size_t ZoneManager::zoneCount() const
+{
+    return zones.size();
+}
+
+StateMachine& ZoneManager::zone(ZoneId id)
+{
+    return *zones.at(id).machine;
+}
+
+void ZoneManager::setExecutor(ZoneExecutor* executor)
+{
+    this->executor = executor;
+}
+
+void ZoneManager::rebuildShards()
+{
+    shards.clear();
+    std::map<int, std::size_t> busShard;
+    for (ZoneId id = 0; id < zones.size(); ++id) {
+        if (!zones[id].busId) {
+            shards.push_back({id});
+            continue;
+        }
+        auto [it, inserted] = busShard.try_emplace(*zones[id].busId, shards.size());
+        if (inserted) shards.emplace_back();
+        shards[it->second].push_back(id);
+    }
+    shardsDirty = false;
+}
+
+void ZoneManager::updateAll()
+{
+    for (auto& zone : zones)
+        zone.due = true;
+    runTicks();
+}
+
+void ZoneManager::updateDue()
+{
+    // one busy zone sets the loop's pace, the others keep their own sampling rate
+    auto now = clock->now();
+    for (auto& zone : zones)
+        zone.due = zone.deadline <= now || zone.machine->hasPendingCommands();
+    runTicks();
+}
+
+bool ZoneManager::ticked(ZoneId id) const
+{
+    return zones.at(id).due;
+}
+
+void ZoneManager::tick(Zone& zone)
+{
+    if (!zone.due) return;
+    zone.machine->update();
+    zone.deadline = zone.machine->nextDeadline();
+}
+
+void ZoneManager::runTicks()
+{
+    if (!executor || executor->threadCount() == 1) {
+        for (auto& zone : zones)
+            tick(zone);
+        return;
+    }
+
+    if (shardsDirty) rebuildShards();
+
+    // Each zone is in exactly one shard and a batch only returns when every shard is done,
+    // so a zone's ticks never overlap and stay in order
+    executor->parallelFor(shards.size(), [this](std::size_t shard) {
+        for (ZoneId id : shards[shard])
+            tick(zones[id]);
+    });
+}
+
+std::chrono::steady_clock::time_point ZoneManager::nextDeadline()
+{
+    // deadlines as of each zone's last tick, a zone that was skipped keeps its own
+    auto earliest = std::chrono::steady_clock::time_point::max();
+    for (auto& zone : zones)
+        earliest = std::min(earliest, zone.deadline);
+    return earliest;
+}
+
+bool ZoneManager::sendCommand(ZoneId id, Command cmd)
+{
+    if (id >= zones.size()) {
+        spdlog::warn("Command for unknown zone {} ignored", id);
+        return false;
+    }
+    return zones[id].machine->sendCommnd(cmd);
+}
+
+void ZoneManager::sendCommandToAll(Command cmd)
+{
+    for (auto& zone : zones)
+        zone.machine->sendCommnd(cmd);
+}
+
+std::optional<Command> ZoneManager::parseCommand(const std::string& payload)
+{
+    if (payload == "START") return Command::START_AUTO;
+    if (payload == "STOP") return Command::EMERGENCY_STOP;
+    if (payload == "MANUAL_ON") return Command::ENABLE_MANUAL;
+    if (payload == "MANUAL_OFF") return Command::DISABLE_MANUAL;
+    return std::nullopt;
+}
+
+bool ZoneManager::handleMessage(const std::string& topic, const std::string& payload)
+{
+    auto cmd = parseCommand(payload);
+    if (!cmd) return false;
+
+    if (topic == SITE_COMMAND_TOPIC) {
+        sendCommandToAll(*cmd);
+        return true;
+    }
+
+    // irrigation/zones/<id>/command
+    if (topic.size() > ZONE_TOPIC_PREFIX.size() + COMMAND_SUFFIX.size() &&
+        topic.compare(0, ZONE_TOPIC_PREFIX.size(), ZONE_TOPIC_PREFIX) == 0 &&
+        topic.compare(topic.size() - COMMAND_SUFFIX.size(), COMMAND_SUFFIX.size(), COMMAND_SUFFIX) == 0)
+    {
+        const char* first = topic.data() + ZONE_TOPIC_PREFIX.size();
+        const char* last = topic.data() + topic.size() - COMMAND_SUFFIX.size();
+        ZoneId id = 0;
+        auto [end, ec] = std::from_chars(first, last, id);
+        if (ec != std::errc() || end != last) {
+            spdlog::warn("Malformed zone command topic: {}", topic);
+            return false;
+        }
+        return sendCommand(id, *cmd);
+    }
+    return false;
+}
+
+std::string ZoneManager::statusJson(ZoneId id)
+{
+    // taken from the zone's last tick, no hardware access here
+    StatusSnapshot snapshot = zones.at(id).machine->getStatus();
+
+    std::string status = "{";
+    status += "\"z\":" + std::to_string(id) + ",";
+    status += "\"s\":" + std::to_string(static_cast<int>(snapshot.state)) + ",";
+    status += "\"m\":" + std::to_string(snapshot.moisture) + ",";
+    status += "\"t\":" + std::to_string(snapshot.temperature) + ",";
+    status += "\"h\":" + std::to_string(snapshot.humidity) + ",";
+    status += "\"p\":" + std::to_string(snapshot.pumpActive ? 1 : 0) + ",";
+    status += "\"r\":" + std::to_string(snapshot.rainDetected ? 1 : 0);
+    status += "}";
+    return status;
+}
+
+void ZoneManager::publishStatus(const PublishCallback& publish)
+{
+    for (ZoneId id = 0; id < zones.size(); ++id) {
+        std::string status = statusJson(id);
+        if (id == 0)
+            publish(SITE_STATUS_TOPIC, status); // single zone topic the GUI listens on
+        publish(statusTopic(id), status);
+    }
+}
+
+std::string ZoneManager::commandTopic(ZoneId id)
+{
+    return ZONE_TOPIC_PREFIX + std::to_string(id) + COMMAND_SUFFIX;
+}
+
+std::string ZoneManager::statusTopic(ZoneId id)
+{
+    return ZONE_TOPIC_PREFIX + std::to_string(id) + "/status";
+}
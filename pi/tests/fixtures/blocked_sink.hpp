@@ -0,0 +1,40 @@
+// tests/fixtures/blocked_sink.hpp
+#ifndef BLOCKED_SINK_HPP
+#define BLOCKED_SINK_HPP
+
+#include <spdlog/sinks/sink.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+// Every log call waits until released, like a sink whose mutex a stuck thread holds
+class BlockedSink : public spdlog::sinks::sink {
+public:
+    void log(const spdlog::details::log_msg&) override {
+        std::unique_lock<std::mutex> lock(mutex);
+        entered = true;
+        signal.notify_all();
+        signal.wait(lock, [this]() { return open; });
+    }
+    void flush() override {}
+    void set_pattern(const std::string&) override {}
+    void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+
+    // true once some thread is stuck inside log()
+    bool waitForEntry(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return signal.wait_for(lock, timeout, [this]() { return entered; });
+    }
+    void release() {
+        { std::lock_guard<std::mutex> lock(mutex); open = true; }
+        signal.notify_all();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable signal;
+    bool entered = false;
+    bool open = false;
+};
+
+#endif // BLOCKED_SINK_HPP
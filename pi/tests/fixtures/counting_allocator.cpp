@@ -0,0 +1,44 @@
+// tests/fixtures/counting_allocator.cpp
+#include "counting_allocator.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace {
+thread_local bool countAllocations = false;
+thread_local std::uint64_t allocations = 0;
+
+void* allocate(std::size_t size)
+{
+    if (countAllocations) ++allocations;
+    if (void* block = std::malloc(size ? size : 1)) return block;
+    throw std::bad_alloc();
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    if (countAllocations) ++allocations;
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+    if (void* block = std::aligned_alloc(align, rounded)) return block;
+    throw std::bad_alloc();
+}
+}
+
+void AllocationCounter::start() { countAllocations = true; }
+void AllocationCounter::stop() { countAllocations = false; }
+std::uint64_t AllocationCounter::count() { return allocations; }
+void AllocationCounter::reset() { allocations = 0; }
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::size_t) noexcept { std::free(block); }
+void operator delete(void* block, std::align_val_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::size_t, std::align_val_t) noexcept { std::free(block); }
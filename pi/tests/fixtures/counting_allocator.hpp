@@ -0,0 +1,19 @@
+// tests/fixtures/counting_allocator.hpp
+#ifndef COUNTING_ALLOCATOR_HPP
+#define COUNTING_ALLOCATOR_HPP
+
+#include <cstdint>
+
+// Counts operator new calls for the allocation-free checks. Linking counting_allocator.cpp
+// replaces the global operator new/delete of the whole binary. Counting is per thread and
+// only while switched on, so other threads and other tests run unaffected.
+class AllocationCounter
+{
+    public:
+        static void start();//counts this thread's allocations from now on
+        static void stop();
+        static std::uint64_t count();//allocations counted on this thread so far
+        static void reset();
+};
+
+#endif // COUNTING_ALLOCATOR_HPP
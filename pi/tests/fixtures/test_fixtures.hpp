@@ -6,6 +6,7 @@
 #include <gmock/gmock.h>
 #include "mock_interfaces.hpp"
 #include "state_machine.hpp"
+#include "clock.hpp"
 #include <thread>
 // Base fixture for state machine tests
 class StateMachineTestFixture : public ::testing::Test {
@@ -44,19 +45,18 @@ protected:
     
     // Helper method to create state machine
     std::unique_ptr<StateMachine> createStateMachine() {
-        return std::make_unique<StateMachine>(&mockSensor, &mockPump, config);
+        return std::make_unique<StateMachine>(&mockSensor, &mockPump, config, &clock);
     }
     
-    // Helper to advance time (simulate time passing)
+    // Helper to advance time (moves the virtual clock, no sleeping)
     void advanceTime(int seconds) {
-        for (int i = 0; i < seconds; ++i) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        }
+        clock.advance(std::chrono::seconds(seconds));
     }
     
     // Test doubles
     MockSensorInterface mockSensor;
     MockPumpInterface mockPump;
+    VirtualClock clock;
     IrrigationConfig config;
 };
 
@@ -9,6 +9,13 @@
 class MockSensorInterface : public ISensorInterface
 {
     public:
+        MockSensorInterface()
+        {
+            // frames are built from the single-channel mocks, so their expectations keep working
+            ON_CALL(*this, readAll()).WillByDefault([this]() {
+                return readEachChannel(std::chrono::steady_clock::now());
+            });
+        }
         virtual ~MockSensorInterface() = default;
 
         MOCK_METHOD(double, getMoisture, (), (override));
@@ -17,6 +24,7 @@ class MockSensorInterface : public ISensorInterface
         MOCK_METHOD(bool, isRainDetected, (), (override));
         MOCK_METHOD(bool, isHealthy, (), (override));
         MOCK_METHOD(bool, initialize, (), (override));
+        MOCK_METHOD(SensorFrame, readAll, (), (override));
 };
 
 // Mock Pump Interface
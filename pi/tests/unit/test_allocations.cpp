@@ -0,0 +1,109 @@
+// tests/unit/test_allocations.cpp
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/details/null_mutex.h>
+#include "state_machine.hpp"
+#include "simulated_hardware.hpp"
+#include "clock.hpp"
+#include "counting_allocator.hpp"
+#include <array>
+
+// Formats every message like a console sink would, then drops it
+class FormattingNullSink : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        spdlog::memory_buf_t formatted;
+        formatter_->format(msg, formatted);
+        bytes += formatted.size();
+    }
+    void flush_() override {}
+public:
+    std::size_t bytes = 0;
+};
+
+// Test Suite: Allocation-free control path
+class AllocationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        previous = spdlog::default_logger();
+        sink = std::make_shared<FormattingNullSink>();
+        spdlog::set_default_logger(std::make_shared<spdlog::logger>("allocations", sink));
+        spdlog::set_level(spdlog::level::info);
+    }
+    void TearDown() override {
+        spdlog::set_default_logger(previous);
+    }
+
+    std::shared_ptr<spdlog::logger> previous;
+    std::shared_ptr<FormattingNullSink> sink;
+};
+
+TEST_F(AllocationTest, SteadyStateUpdateNeverAllocates) {
+    VirtualClock clock;
+    SimulatedHardware sim(&clock);
+    auto config = IrrigationConfig::forSandy("Alloc");
+    config.waitMinutes = 1;
+    config.minWateringIntervalMinutes = 1;
+    StateMachine machine(&sim, &sim, config, &clock);
+    sim.setScenario(SimulatedHardware::Scenario::DRY);
+    machine.sendCommnd(Command::START_AUTO);
+
+    auto tick = [&]() {
+        clock.advance(StateMachine::TICK_PERIOD);
+        sim.update();
+        AllocationCounter::start();
+        machine.update();
+        AllocationCounter::stop();
+    };
+
+    // startup: first log lines, first state visits
+    for (int i = 0; i < 2000; ++i) tick();
+
+    AllocationCounter::reset();
+    std::array<int, STATE_COUNT> visits{};
+    for (int i = 0; i < 20000; ++i) {
+        tick();
+        ++visits[static_cast<std::size_t>(machine.getCurrentState())];
+    }
+
+    EXPECT_EQ(AllocationCounter::count(), 0u);
+    EXPECT_GT(visits[static_cast<std::size_t>(SystemState::WATERING)], 0);
+    EXPECT_GT(visits[static_cast<std::size_t>(SystemState::WAITING)], 0);
+    EXPECT_GT(sink->bytes, 0u);  // logging was really formatted
+}
+
+TEST_F(AllocationTest, CommandsAndConfigUpdatesDoNotAllocateInUpdate) {
+    VirtualClock clock;
+    SimulatedHardware sim(&clock);
+    StateMachine machine(&sim, &sim, IrrigationConfig::forLoam("Alloc"), &clock);
+    machine.update();
+
+    IrrigationConfig next = machine.getConfig();
+    AllocationCounter::reset();
+    for (int i = 0; i < 200; ++i) {
+        // producers may allocate, the tick that picks their work up may not
+        machine.sendCommnd(i % 2 ? Command::ENABLE_MANUAL : Command::DISABLE_MANUAL);
+        next.lowMoistureThreshold = 25.0 + i % 10;
+        machine.updateConfig(next);
+
+        clock.advance(StateMachine::TICK_PERIOD);
+        AllocationCounter::start();
+        machine.update();
+        AllocationCounter::stop();
+    }
+
+    EXPECT_EQ(AllocationCounter::count(), 0u);
+}
+
+TEST_F(AllocationTest, HarnessSeesAllocations) {
+    // a new-expression may be elided by the optimizer, a direct operator new call may not
+    void* volatile block = nullptr;
+    AllocationCounter::reset();
+    AllocationCounter::start();
+    block = ::operator new(64);
+    AllocationCounter::stop();
+    ::operator delete(block);
+    EXPECT_EQ(AllocationCounter::count(), 1u);
+    AllocationCounter::reset();
+}
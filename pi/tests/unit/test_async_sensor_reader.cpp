@@ -0,0 +1,151 @@
+// tests/unit/test_async_sensor_reader.cpp
+#include <gtest/gtest.h>
+#include "async_sensor_reader.hpp"
+#include "test_fixtures.hpp"
+#include <atomic>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+// Sensor with an adjustable conversion time per channel
+class ConvertingSensor : public ISensorInterface {
+public:
+    bool initialize() override { return true; }
+    double getMoisture() override { return convert(moistureLatency, moisture); }
+    double getTemp() override { return convert(temperatureLatency, temperature); }
+    double getHumid() override { return convert(humidityLatency, humidity); }
+    bool isRainDetected() override { return false; }
+    bool isHealthy() override { return true; }
+    SensorFrame readAll() override { return readEachChannel(std::chrono::steady_clock::now()); }
+
+    std::atomic<double> moisture{40.0};
+    std::atomic<double> temperature{22.0};
+    std::atomic<double> humidity{55.0};
+    std::atomic<int> moistureLatency{0};     // milliseconds
+    std::atomic<int> temperatureLatency{0};
+    std::atomic<int> humidityLatency{0};
+
+private:
+    double convert(std::atomic<int>& latency, std::atomic<double>& value) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(latency.load()));
+        return value.load();
+    }
+};
+}
+
+// Test Suite: Per-channel deadlines
+class AsyncSensorReaderTest : public ::testing::Test {
+protected:
+    ConvertingSensor sensor;
+    AsyncSensorReader::Deadlines deadlines{20ms, 20ms, 20ms};
+};
+
+TEST_F(AsyncSensorReaderTest, FastChannelsAreConvertedForTheFrame) {
+    AsyncSensorReader reader(&sensor, deadlines);
+    SensorFrame frame = reader.readAll();
+    
+    EXPECT_DOUBLE_EQ(frame.moisture, 40.0);
+    EXPECT_DOUBLE_EQ(frame.temperature, 22.0);
+    EXPECT_DOUBLE_EQ(frame.humidity, 55.0);
+    EXPECT_TRUE(frame.temperatureValid);
+    EXPECT_EQ(frame.moistureAge.count(), 0);
+    EXPECT_EQ(frame.temperatureAge.count(), 0);
+    EXPECT_EQ(reader.lateCount(SensorChannel::TEMPERATURE), 0u);
+}
+
+TEST_F(AsyncSensorReaderTest, LateChannelReusesLastGoodValue) {
+    AsyncSensorReader reader(&sensor, deadlines);
+    reader.readAll();
+    
+    sensor.temperature = 30.0;
+    sensor.temperatureLatency = 300;  // DHT22-like conversion, far past the deadline
+    
+    auto start = std::chrono::steady_clock::now();
+    SensorFrame frame = reader.readAll();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 200ms);
+    
+    EXPECT_DOUBLE_EQ(frame.temperature, 22.0);
+    EXPECT_TRUE(frame.temperatureValid);
+    EXPECT_GT(frame.temperatureAge.count(), 0);
+    EXPECT_EQ(frame.moistureAge.count(), 0);  // other channels are not held up
+    EXPECT_EQ(reader.lateCount(SensorChannel::TEMPERATURE), 1u);
+}
+
+TEST_F(AsyncSensorReaderTest, LateResultIsUsedByALaterRead) {
+    AsyncSensorReader reader(&sensor, deadlines);
+    sensor.humidity = 70.0;
+    sensor.humidityLatency = 60;
+    
+    SensorFrame first = reader.readAll();
+    EXPECT_FALSE(first.humidityValid);  // nothing converted yet
+    EXPECT_GT(first.humidityAge.count(), 0);  // and not passed off as a fresh value
+    
+    std::this_thread::sleep_for(100ms);
+    sensor.humidityLatency = 0;
+    SensorFrame second = reader.readAll();
+    EXPECT_TRUE(second.humidityValid);
+    EXPECT_DOUBLE_EQ(second.humidity, 70.0);
+    EXPECT_EQ(second.humidityAge.count(), 0);
+}
+
+TEST_F(AsyncSensorReaderTest, ResultOfAnEarlierReadKeepsItsAge) {
+    AsyncSensorReader reader(&sensor, deadlines);
+    reader.readAll();
+    sensor.moistureLatency = 60;  // always slower than the deadline
+    
+    // a conversion finishing between reads was not made for the next one
+    int valuesTaken = 0;
+    double previous = reader.readAll().moisture;
+    for (int i = 0; i < 8; ++i) {
+        sensor.moisture = 41.0 + i;
+        std::this_thread::sleep_for(40ms);
+        SensorFrame frame = reader.readAll();
+        EXPECT_GT(frame.moistureAge.count(), 0);
+        EXPECT_LT(frame.moistureAge, 200ms);
+        if (frame.moisture != previous) ++valuesTaken;
+        previous = frame.moisture;
+    }
+    EXPECT_EQ(reader.lateCount(SensorChannel::MOISTURE), 9u);
+    EXPECT_GE(valuesTaken, 3);  // the next conversion starts as soon as a result is taken
+    
+    sensor.moistureLatency = 0;
+    std::this_thread::sleep_for(100ms);  // the last slow conversion is done, its result is old
+    EXPECT_EQ(reader.readAll().moistureAge.count(), 0);
+}
+
+// Test Suite: State machine behind the async reader
+class AsyncStateMachineTest : public StateMachineTestFixture {};
+
+TEST_F(AsyncStateMachineTest, SlowConversionDoesNotStallTheTick) {
+    ConvertingSensor slowSensor;
+    AsyncSensorReader reader(&slowSensor, AsyncSensorReader::Deadlines{20ms, 20ms, 20ms});
+    auto sm = std::make_unique<StateMachine>(&reader, &mockPump, config, &clock);
+    
+    sm->sendCommnd(Command::START_AUTO);
+    sm->update();
+    slowSensor.moistureLatency = 300;
+    
+    auto start = std::chrono::steady_clock::now();
+    sm->update();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 200ms);
+    
+    EXPECT_EQ(sm->getCurrentState(), SystemState::MONITORING);
+    EXPECT_DOUBLE_EQ(sm->getStatus().moisture, 40.0);
+}
+
+TEST_F(AsyncStateMachineTest, NoConversionYetIsNotASample) {
+    ConvertingSensor slowSensor;
+    slowSensor.moistureLatency = 20;
+    AsyncSensorReader reader(&slowSensor, AsyncSensorReader::Deadlines{1ms, 1ms, 1ms});
+    auto sm = std::make_unique<StateMachine>(&reader, &mockPump, config, &clock);
+    
+    sm->sendCommnd(Command::START_AUTO);
+    sm->update();
+    
+    // the boot tick got no moisture value, it must not count as a 0% reading
+    FlightRecord record;
+    ASSERT_TRUE(sm->flightRecorder().latest(record));
+    EXPECT_FALSE(record.flags & FlightRecord::FRESH_FRAME);
+    EXPECT_EQ(record.lowReadings, 0u);
+}
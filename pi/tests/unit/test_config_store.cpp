@@ -0,0 +1,85 @@
+// tests/unit/test_config_store.cpp
+#include <gtest/gtest.h>
+#include "config_store.hpp"
+#include "state_machine.hpp"
+#include <atomic>
+#include <thread>
+
+// Test Suite: Versioned config snapshots
+class ConfigStoreTest : public ::testing::Test {
+protected:
+    IrrigationConfig withThreshold(double low) {
+        IrrigationConfig config;
+        config.lowMoistureThreshold = low;
+        return config;
+    }
+};
+
+TEST_F(ConfigStoreTest, PinSeesLatestVersion) {
+    ConfigStore<IrrigationConfig> store(withThreshold(30.0));
+    EXPECT_EQ(store.pin().version, 1u);
+    
+    EXPECT_EQ(store.update(withThreshold(25.0)), 2u);
+    
+    const auto& snapshot = store.pin();
+    EXPECT_EQ(snapshot.version, 2u);
+    EXPECT_DOUBLE_EQ(snapshot.value.lowMoistureThreshold, 25.0);
+    EXPECT_DOUBLE_EQ(store.get().lowMoistureThreshold, 25.0);
+}
+
+TEST_F(ConfigStoreTest, PinnedSnapshotSurvivesUpdates) {
+    ConfigStore<IrrigationConfig> store(withThreshold(30.0));
+    const auto& pinned = store.pin();
+    
+    for (int i = 0; i < 10; ++i) store.update(withThreshold(20.0 + i));
+    
+    // the reader has not moved on, nothing it may hold is freed
+    EXPECT_DOUBLE_EQ(pinned.value.lowMoistureThreshold, 30.0);
+    EXPECT_EQ(store.retiredCount(), 10u);
+}
+
+TEST_F(ConfigStoreTest, RetiredSnapshotsFreedOnceReaderMovesOn) {
+    ConfigStore<IrrigationConfig> store(withThreshold(30.0));
+    store.pin();
+    for (int i = 0; i < 5; ++i) store.update(withThreshold(20.0 + i));
+    
+    store.pin();  // reader now on version 6
+    store.update(withThreshold(10.0));
+    
+    // only the snapshot the reader still holds is kept
+    EXPECT_EQ(store.retiredCount(), 1u);
+}
+
+TEST_F(ConfigStoreTest, ReaderNeverSeesTornSnapshot) {
+    IrrigationConfig initial = withThreshold(0.0);
+    initial.highMoistureThreshold = 40.0;
+    ConfigStore<IrrigationConfig> store(initial);
+    std::atomic<bool> done{false};
+    
+    std::thread writer([&]() {
+        for (int i = 1; i <= 2000; ++i) {
+            IrrigationConfig config = withThreshold(i);
+            config.highMoistureThreshold = i + 40.0;
+            config.zoneName = "Zone " + std::to_string(i);
+            store.update(config);
+            std::this_thread::yield();
+        }
+        done = true;
+    });
+    
+    std::uint64_t lastVersion = 0;
+    while (!done) {
+        const auto& snapshot = store.pin();
+        const auto& config = snapshot.value;
+        EXPECT_GE(snapshot.version, lastVersion);
+        EXPECT_DOUBLE_EQ(config.highMoistureThreshold - config.lowMoistureThreshold, 40.0);
+        if (snapshot.version > 1) {
+            EXPECT_EQ(config.zoneName, "Zone " + std::to_string(static_cast<int>(config.lowMoistureThreshold)));
+        }
+        lastVersion = snapshot.version;
+        std::this_thread::yield();
+    }
+    writer.join();
+    
+    EXPECT_EQ(store.pin().version, 2001u);
+}
@@ -0,0 +1,69 @@
+// tests/unit/test_event_loop.cpp
+#include <gtest/gtest.h>
+#include "event_loop.hpp"
+#include <thread>
+
+// Test Suite: Deadline driven event loop
+class EventLoopTest : public ::testing::Test {
+protected:
+    EventLoop loop;
+};
+
+TEST_F(EventLoopTest, OneShotTimerFiresAtDeadline) {
+    int fired = 0;
+    EventLoop::TimerId timer = loop.addTimer([&]() {
+        fired++;
+        loop.stop();
+    });
+    
+    auto start = std::chrono::steady_clock::now();
+    loop.armAt(timer, start + std::chrono::milliseconds(20));
+    loop.run();
+    
+    EXPECT_EQ(fired, 1);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST_F(EventLoopTest, PastDeadlineFiresImmediately) {
+    int fired = 0;
+    EventLoop::TimerId timer = loop.addTimer([&]() {
+        fired++;
+        loop.stop();
+    });
+    
+    loop.armAt(timer, std::chrono::steady_clock::now() - std::chrono::seconds(1));
+    loop.run();
+    
+    EXPECT_EQ(fired, 1);
+}
+
+TEST_F(EventLoopTest, PeriodicTimerRepeats) {
+    int fired = 0;
+    EventLoop::TimerId timer = loop.addTimer([&]() {
+        if (++fired == 3) loop.stop();
+    });
+    
+    loop.armEvery(timer, std::chrono::milliseconds(5));
+    loop.run();
+    
+    EXPECT_EQ(fired, 3);
+}
+
+TEST_F(EventLoopTest, WakeFromOtherThreadRunsHandler) {
+    int woken = 0;
+    loop.setWakeHandler([&]() {
+        woken++;
+        loop.stop();
+    });
+    
+    // A far away deadline must not delay the wake
+    EventLoop::TimerId timer = loop.addTimer([]() {});
+    loop.armAt(timer, std::chrono::steady_clock::now() + std::chrono::hours(1));
+    
+    std::thread producer([this]() { loop.wake(); });
+    loop.run();
+    producer.join();
+    
+    EXPECT_EQ(woken, 1);
+    EXPECT_EQ(loop.wakeupCount(), 1u);
+}
@@ -0,0 +1,156 @@
+// tests/unit/test_flight_recorder.cpp
+#include <gtest/gtest.h>
+#include "flight_recorder.hpp"
+#include "test_fixtures.hpp"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+// Test Suite: Flight recorder ring and dump format
+class FlightRecorderTest : public ::testing::Test {
+protected:
+    static FlightRecord entry(std::uint64_t tick) {
+        FlightRecord r;
+        r.tick = tick;
+        r.moisture = static_cast<double>(tick);
+        r.filteredMoisture = static_cast<double>(tick) / 2;
+        return r;
+    }
+
+    // one file per test, ctest runs the tests of this suite in parallel processes
+    std::string path = ::testing::TempDir() + "flight_" +
+                       ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".bin";
+    void TearDown() override { std::remove(path.c_str()); }
+};
+
+TEST_F(FlightRecorderTest, CapacityIsRoundedToPowerOfTwo) {
+    EXPECT_EQ(FlightRecorder(100).capacity(), 128u);
+    EXPECT_EQ(FlightRecorder(64).capacity(), 64u);
+}
+
+TEST_F(FlightRecorderTest, KeepsNewestRecordsOldestFirst) {
+    FlightRecorder recorder(8);
+    for (std::uint64_t tick = 1; tick <= 20; ++tick) recorder.record(entry(tick));
+
+    auto records = recorder.snapshot();
+    ASSERT_EQ(records.size(), 8u);
+    EXPECT_EQ(records.front().tick, 13u);
+    EXPECT_EQ(records.back().tick, 20u);
+    EXPECT_EQ(recorder.recorded(), 20u);
+}
+
+TEST_F(FlightRecorderTest, DumpRoundTrips) {
+    FlightRecorder recorder(16);
+    for (std::uint64_t tick = 1; tick <= 5; ++tick) recorder.record(entry(tick));
+
+    ASSERT_TRUE(recorder.dump(path, "Back Lawn", FlightDumpReason::ERROR));
+    FlightDumpHeader header;
+    std::vector<FlightRecord> records;
+    ASSERT_TRUE(FlightRecorder::load(path, header, records));
+
+    EXPECT_STREQ(header.zone, "Back Lawn");
+    EXPECT_EQ(header.reason, FlightDumpReason::ERROR);
+    EXPECT_EQ(header.count, 5u);
+    ASSERT_EQ(records.size(), 5u);
+    EXPECT_EQ(records[4].tick, 5u);
+    EXPECT_DOUBLE_EQ(records[4].filteredMoisture, 2.5);
+}
+
+TEST_F(FlightRecorderTest, RejectsForeignFiles) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("not a flight recorder dump, just some text that is long enough for a header", file);
+    std::fclose(file);
+
+    FlightDumpHeader header;
+    std::vector<FlightRecord> records;
+    EXPECT_FALSE(FlightRecorder::load(path, header, records));
+    EXPECT_FALSE(FlightRecorder::load(path + ".missing", header, records));
+}
+
+TEST_F(FlightRecorderTest, SnapshotWhileRecordingSeesWholeRecordsInOrder) {
+    FlightRecorder recorder(64);
+    std::atomic<bool> stop{false};
+    std::thread writer([&]() {
+        for (std::uint64_t tick = 1; !stop.load(std::memory_order_relaxed); ++tick)
+            recorder.record(entry(tick));
+    });
+
+    for (int i = 0; i < 200; ++i) {
+        auto records = recorder.snapshot();
+        for (std::size_t j = 0; j < records.size(); ++j) {
+            ASSERT_EQ(records[j].moisture, static_cast<double>(records[j].tick));
+            if (j > 0) ASSERT_EQ(records[j].tick, records[j - 1].tick + 1);
+        }
+    }
+    stop = true;
+    writer.join();
+}
+
+// Test Suite: What the state machine puts into its recorder
+class StateMachineFlightTest : public StateMachineTestFixture {};
+
+TEST_F(StateMachineFlightTest, RecordsEveryTick) {
+    auto sm = createStateMachine();
+    sm->sendCommnd(Command::START_AUTO);
+    sm->update();
+    sm->update();
+
+    auto records = sm->flightRecorder().snapshot();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].tick, 1u);
+    EXPECT_EQ(records[0].commands, 1u);
+    EXPECT_EQ(records[0].state, static_cast<std::uint8_t>(SystemState::MONITORING));
+    EXPECT_EQ(records[0].configVersion, 1u);
+    EXPECT_TRUE(records[0].flags & FlightRecord::SENSOR_READ);
+    EXPECT_DOUBLE_EQ(records[1].moisture, 50.0);
+    EXPECT_TRUE(std::isnan(records[1].changeRate));
+}
+
+TEST_F(StateMachineFlightTest, CapacityComesFromConfig) {
+    EXPECT_EQ(createStateMachine()->flightRecorder().capacity(), FlightRecorder::DEFAULT_CAPACITY);
+
+    config.flightRecords = 16;
+    auto sm = createStateMachine();
+    EXPECT_EQ(sm->flightRecorder().capacity(), 16u);
+    for (int i = 0; i < 40; ++i) sm->update();
+
+    auto records = sm->flightRecorder().snapshot();
+    ASSERT_EQ(records.size(), 16u);
+    EXPECT_EQ(records.back().tick, 40u);
+}
+
+TEST_F(StateMachineFlightTest, ErrorEntryRequestsOneDump) {
+    auto sm = createStateMachine();
+    sm->sendCommnd(Command::START_AUTO);
+    sm->update();
+    EXPECT_FALSE(sm->takeErrorDump());
+
+    sm->emergencyStop();
+    sm->update();
+
+    auto records = sm->flightRecorder().snapshot();
+    EXPECT_EQ(records.back().nextState, static_cast<std::uint8_t>(SystemState::ERROR));
+    EXPECT_TRUE(records.back().flags & FlightRecord::EMERGENCY_STOP);
+    EXPECT_TRUE(sm->takeErrorDump());
+    EXPECT_FALSE(sm->takeErrorDump());
+
+    sm->update();  // staying in ERROR asks for nothing new
+    EXPECT_FALSE(sm->takeErrorDump());
+}
+
+TEST_F(StateMachineFlightTest, RecordsPumpActions) {
+    auto sm = createStateMachine();
+    sm->sendCommnd(Command::ENABLE_MANUAL);
+    sm->update();
+    sm->sendCommnd(Command::DISABLE_MANUAL);
+    sm->update();
+
+    auto records = sm->flightRecorder().snapshot();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_TRUE(records[0].flags & FlightRecord::PUMP_STARTED);
+    EXPECT_TRUE(records[0].flags & FlightRecord::PUMP_RUNNING);
+    EXPECT_TRUE(records[1].flags & FlightRecord::PUMP_STOPPED);
+    EXPECT_FALSE(records[1].flags & FlightRecord::PUMP_RUNNING);
+}
@@ -1,6 +1,7 @@
 // tests/unit/test_irrigation_logic.cpp
 #include <gtest/gtest.h>
 #include "irrigation_logic.hpp"
+#include <vector>
 
 // Test Suite: Sensor Reading Validation
 class SensorValidationTest : public ::testing::Test {};
@@ -26,7 +27,7 @@ TEST_F(SensorValidationTest, BoundaryValues) {
 // Test Suite: Filtered Moisture Calculation
 class FilteredMoistureTest : public ::testing::Test {
 protected:
-    std::deque<sensorReading> readings;
+    std::vector<sensorReading> readings;
     
     void addReading(double moisture, int secondsAgo = 0) {
         auto timestamp = std::chrono::steady_clock::now() - 
@@ -72,11 +73,12 @@ TEST_F(FilteredMoistureTest, LessThanFiveReadingsUsesAll) {
 // Test Suite: Moisture Change Rate
 class MoistureChangeRateTest : public ::testing::Test {
 protected:
-    std::deque<sensorReading> readings;
+    std::vector<sensorReading> readings;
+    // fixed "now", the rate has sub-second resolution
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
     
     void addReading(double moisture, int minutesAgo) {
-        auto timestamp = std::chrono::steady_clock::now() - 
-                        std::chrono::minutes(minutesAgo);
+        auto timestamp = now - std::chrono::minutes(minutesAgo);
         readings.push_back({moisture, timestamp, true});
     }
 };
@@ -108,6 +110,27 @@ TEST_F(MoistureChangeRateTest, CalculatesNegativeChangeRate) {
     EXPECT_DOUBLE_EQ(rate.value(), -1.0);
 }
 
+TEST_F(MoistureChangeRateTest, FitsAllReadingsNotJustEndpoints) {
+    addReading(30.0, 3);
+    addReading(31.0, 2);
+    addReading(32.0, 1);
+    addReading(31.0, 0);   // noisy last sample
+    
+    // least squares: 0.4%/min, the endpoints alone would say 0.33
+    auto rate = IrrigarionLogic::getMoistuerChangeRate(readings);
+    ASSERT_TRUE(rate.has_value());
+    EXPECT_NEAR(rate.value(), 0.4, 1e-9);
+}
+
+TEST_F(MoistureChangeRateTest, ResolvesSubMinuteSpans) {
+    readings.push_back({40.0, now - std::chrono::seconds(2), true});
+    readings.push_back({40.1, now, true});
+    
+    auto rate = IrrigarionLogic::getMoistuerChangeRate(readings);
+    ASSERT_TRUE(rate.has_value());
+    EXPECT_NEAR(rate.value(), 3.0, 1e-9);
+}
+
 TEST_F(MoistureChangeRateTest, InvalidReadingsReturnNullopt) {
     readings.push_back({30.0, std::chrono::steady_clock::now(), false});  // Invalid
     readings.push_back({50.0, std::chrono::steady_clock::now(), true});
@@ -0,0 +1,80 @@
+// tests/unit/test_latency_histogram.cpp
+#include <gtest/gtest.h>
+#include "latency_histogram.hpp"
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+// Test Suite: Log-linear latency histogram
+class LatencyHistogramTest : public ::testing::Test {
+protected:
+    LatencyHistogram histogram;
+};
+
+TEST_F(LatencyHistogramTest, EmptyReportsZero) {
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.percentile(99).count(), 0);
+    EXPECT_EQ(histogram.mean().count(), 0);
+}
+
+TEST_F(LatencyHistogramTest, BucketEdgesCoverEveryValue) {
+    // every value falls inside its bucket and the bucket is at most 1/8 wide
+    for (std::uint64_t ns : {0ull, 7ull, 8ull, 15ull, 16ull, 1000ull, 123456ull, 99999999ull}) {
+        std::size_t bucket = LatencyHistogram::bucketFor(ns);
+        EXPECT_GE(LatencyHistogram::upperEdge(bucket), ns);
+        if (bucket > 0) EXPECT_LT(LatencyHistogram::upperEdge(bucket - 1), ns);
+        EXPECT_LE(LatencyHistogram::upperEdge(bucket) - ns, ns / LatencyHistogram::SUB_BUCKETS);
+    }
+}
+
+TEST_F(LatencyHistogramTest, PercentilesWithinBucketResolution) {
+    for (int i = 1; i <= 1000; ++i) histogram.record(std::chrono::microseconds(i));
+    
+    EXPECT_EQ(histogram.count(), 1000u);
+    EXPECT_EQ(histogram.min(), 1us);
+    EXPECT_EQ(histogram.max(), 1000us);
+    EXPECT_NEAR(histogram.percentile(50).count(), 500000.0, 500000.0 / 8);
+    EXPECT_NEAR(histogram.percentile(99).count(), 990000.0, 990000.0 / 8);
+    EXPECT_EQ(histogram.percentile(100), 1000us);
+}
+
+TEST_F(LatencyHistogramTest, OutliersShowInTailOnly) {
+    for (int i = 0; i < 999; ++i) histogram.record(100us);
+    histogram.record(40ms);
+    
+    EXPECT_LE(histogram.percentile(99), 100us + 100us / 8);
+    EXPECT_EQ(histogram.max(), 40ms);
+}
+
+TEST_F(LatencyHistogramTest, NegativeAndHugeValuesAreClamped) {
+    histogram.record(-5ms);
+    histogram.record(std::chrono::hours(2));
+    
+    EXPECT_EQ(histogram.count(), 2u);
+    EXPECT_EQ(histogram.min().count(), 0);
+    EXPECT_EQ(histogram.percentile(100), std::chrono::hours(2));
+}
+
+TEST_F(LatencyHistogramTest, MergeAndReset) {
+    LatencyHistogram other;
+    histogram.record(1ms);
+    other.record(3ms);
+    histogram.merge(other);
+    
+    EXPECT_EQ(histogram.count(), 2u);
+    EXPECT_EQ(histogram.mean(), 2ms);
+    EXPECT_EQ(histogram.max(), 3ms);
+    
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.max().count(), 0);
+}
+
+TEST_F(LatencyHistogramTest, JsonSummaryInMicroseconds) {
+    histogram.record(250us);
+    
+    std::string json = histogram.toJson();
+    EXPECT_NE(json.find("\"count\":1"), std::string::npos);
+    EXPECT_NE(json.find("\"max_us\":250"), std::string::npos);
+    EXPECT_NE(json.find("\"p99_us\":250"), std::string::npos);
+}
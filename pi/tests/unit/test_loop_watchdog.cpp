@@ -0,0 +1,180 @@
+// tests/unit/test_loop_watchdog.cpp
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "loop_watchdog.hpp"
+#include "log_timing.hpp"
+#include <spdlog/spdlog.h>
+#include "test_fixtures.hpp"
+#include "blocked_sink.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace std::chrono_literals;
+using ::testing::Return;
+
+static TickTiming timingOf(SystemState state, std::chrono::nanoseconds total, TickPhase slowest)
+{
+    TickTiming timing;
+    timing.state = state;
+    timing.total = total;
+    timing.phase(slowest) = total;
+    return timing;
+}
+
+// Test Suite: Overrun accounting
+class LoopWatchdogTest : public ::testing::Test {
+protected:
+    LoopWatchdog::Limits limits{10ms, 2000ms};
+};
+
+TEST_F(LoopWatchdogTest, CountsOverrunsPerState) {
+    LoopWatchdog watchdog(limits, nullptr);
+    watchdog.record(timingOf(SystemState::IDLE, 5ms, TickPhase::LOGIC));
+    watchdog.record(timingOf(SystemState::WATERING, 15ms, TickPhase::SENSORS));
+    watchdog.record(timingOf(SystemState::WATERING, 12ms, TickPhase::LOGGING));
+    watchdog.record(timingOf(SystemState::ERROR, 10ms, TickPhase::LOGIC));  // exactly on budget
+    
+    EXPECT_EQ(watchdog.tickCount(), 4u);
+    EXPECT_EQ(watchdog.overrunCount(), 2u);
+    EXPECT_EQ(watchdog.overrunCount(SystemState::WATERING), 2u);
+    EXPECT_EQ(watchdog.overrunCount(SystemState::IDLE), 0u);
+}
+
+TEST_F(LoopWatchdogTest, KeepsSlowestTicksWithTheirCause) {
+    LoopWatchdog watchdog(limits, nullptr);
+    for (int i = 1; i <= 20; ++i)
+        watchdog.record(timingOf(SystemState::MONITORING, std::chrono::milliseconds(10 + i),
+                                 i == 20 ? TickPhase::COMMANDS : TickPhase::SENSORS));
+    
+    ASSERT_EQ(watchdog.worstCount(), LoopWatchdog::WORST_KEPT);
+    EXPECT_EQ(watchdog.worst()[0].total, 30ms);
+    EXPECT_EQ(watchdog.worst()[0].cause(), TickPhase::COMMANDS);
+    EXPECT_EQ(watchdog.worst()[LoopWatchdog::WORST_KEPT - 1].total, 23ms);
+    EXPECT_EQ(watchdog.worst()[1].cause(), TickPhase::SENSORS);
+}
+
+TEST_F(LoopWatchdogTest, SummaryNamesStatesAndCauses) {
+    LoopWatchdog watchdog(limits, nullptr);
+    watchdog.record(timingOf(SystemState::WATERING, 25ms, TickPhase::LOGGING));
+    
+    std::string json = watchdog.summaryJson();
+    EXPECT_NE(json.find("\"overruns\":1"), std::string::npos);
+    EXPECT_NE(json.find("\"WATERING\":1"), std::string::npos);
+    EXPECT_NE(json.find("\"cause\":\"logging\""), std::string::npos);
+    EXPECT_NE(json.find("\"total_us\":25000"), std::string::npos);
+}
+
+// Test Suite: Stall detection
+TEST_F(LoopWatchdogTest, StalledIterationForcesHandlerOnce) {
+    std::atomic<int> calls{0};
+    LoopWatchdog watchdog({10ms, 40ms}, [&]() { ++calls; });
+    watchdog.start();
+    
+    watchdog.beginIteration();
+    auto until = std::chrono::steady_clock::now() + 200ms;
+    while (std::chrono::steady_clock::now() < until) std::this_thread::sleep_for(5ms);
+    watchdog.endIteration();
+    watchdog.stop();
+    
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(watchdog.stallCount(), 1u);
+}
+
+TEST_F(LoopWatchdogTest, ShortIterationsNeverStall) {
+    std::atomic<int> calls{0};
+    LoopWatchdog watchdog({10ms, 100ms}, [&]() { ++calls; });
+    watchdog.start();
+    
+    for (int i = 0; i < 20; ++i) {
+        watchdog.beginIteration();
+        std::this_thread::sleep_for(1ms);
+        watchdog.endIteration();
+        std::this_thread::sleep_for(10ms);
+    }
+    watchdog.stop();
+    
+    EXPECT_EQ(calls.load(), 0);
+}
+
+TEST_F(LoopWatchdogTest, BlockedLoggerDoesNotHoldUpTheCutOff) {
+    ::testing::NiceMock<MockSensorInterface> sensors[2];
+    ::testing::NiceMock<MockPumpInterface> pumps[2];
+    StateMachine zone0(&sensors[0], &pumps[0], IrrigationConfig{});
+    StateMachine zone1(&sensors[1], &pumps[1], IrrigationConfig{});
+    EXPECT_CALL(pumps[0], deactivate()).Times(1);
+    EXPECT_CALL(pumps[1], deactivate()).Times(1);
+    
+    auto sink = std::make_shared<BlockedSink>();
+    auto previous = spdlog::default_logger();
+    auto blocked = std::make_shared<spdlog::logger>("blocked", sink);
+    blocked->set_level(spdlog::level::trace);
+    spdlog::set_default_logger(blocked);
+    
+    std::atomic<bool> cut{false};
+    LoopWatchdog watchdog({10ms, 40ms}, [&]() {
+        zone0.emergencyStop();
+        zone1.emergencyStop();
+        cut = true;
+    });
+    watchdog.start();
+    
+    watchdog.beginIteration();
+    std::thread stuck([]() { spdlog::info("control thread stuck in a sink"); });
+    auto deadline = std::chrono::steady_clock::now() + 1s;
+    while (!cut && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(5ms);
+    EXPECT_TRUE(cut.load());  // while the sink is still blocked
+    
+    sink->release();
+    stuck.join();
+    watchdog.endIteration();
+    watchdog.stop();
+    spdlog::set_default_logger(previous);
+    EXPECT_EQ(watchdog.stallCount(), 1u);
+}
+
+// Test Suite: Tick phase timing
+class TickTimingTest : public StateMachineTestFixture {};
+
+TEST_F(TickTimingTest, SlowSensorIsBlamed) {
+    EXPECT_CALL(mockSensor, readAll()).WillRepeatedly([]() {
+        std::this_thread::sleep_for(5ms);
+        SensorFrame frame;
+        frame.moisture = 50.0;
+        frame.healthy = true;
+        frame.validate();
+        return frame;
+    });
+    auto sm = createStateMachine();
+    sm->update();
+    
+    const TickTiming& timing = sm->lastTick();
+    EXPECT_EQ(timing.state, SystemState::IDLE);
+    EXPECT_EQ(timing.tick, 1u);
+    EXPECT_GE(timing.phase(TickPhase::SENSORS), 5ms);
+    EXPECT_EQ(timing.cause(), TickPhase::SENSORS);
+    
+    std::chrono::nanoseconds sum{0};
+    for (auto phase : timing.phases) sum += phase;
+    EXPECT_LE(sum, timing.total);
+}
+
+TEST_F(TickTimingTest, TimedSinkMeasuresThisThread) {
+    class SlowSink : public spdlog::sinks::sink {
+    public:
+        void log(const spdlog::details::log_msg&) override { std::this_thread::sleep_for(2ms); }
+        void flush() override {}
+        void set_pattern(const std::string&) override {}
+        void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+    };
+    auto logger = std::make_shared<spdlog::logger>("timed", std::make_shared<TimedSink>(std::make_shared<SlowSink>()));
+    
+    auto before = TimedSink::threadTotal();
+    logger->info("slow");
+    EXPECT_GE(TimedSink::threadTotal() - before, 2ms);
+    
+    std::chrono::nanoseconds otherThread{0};
+    std::thread([&]() { otherThread = TimedSink::threadTotal(); }).join();
+    EXPECT_EQ(otherThread.count(), 0);
+}
@@ -0,0 +1,79 @@
+// tests/unit/test_moisture_filter.cpp
+#include <gtest/gtest.h>
+#include "moisture_filter.hpp"
+#include "irrigation_logic.hpp"
+#include <vector>
+
+// Test Suite: Incremental moisture filters
+class MoistureFilterTest : public ::testing::Test {};
+
+TEST_F(MoistureFilterTest, MovingAverageMatchesIrrigationLogic) {
+    MoistureFilter filter(FilterKind::MOVING_AVERAGE, 5);
+    std::vector<sensorReading> readings;
+    
+    for (double m : {20.0, 25.0, 30.0, 35.0, 40.0, 45.0, 50.0}) {
+        readings.push_back({m, std::chrono::steady_clock::now(), true});
+        EXPECT_DOUBLE_EQ(filter.add(m), IrrigarionLogic::getFilteredMoisture(readings));
+    }
+}
+
+TEST_F(MoistureFilterTest, MovingAverageStaysExactOverLongRuns) {
+    MoistureFilter filter(FilterKind::MOVING_AVERAGE, 1000);
+    for (int i = 0; i < 100000; ++i) filter.add(i % 2 ? 40.1 : 39.9);
+    
+    EXPECT_NEAR(filter.value(), 40.0, 1e-9);
+}
+
+TEST_F(MoistureFilterTest, ExponentialConvergesToStepValue) {
+    MoistureFilter filter(FilterKind::EXPONENTIAL, 9);  // alpha 0.2
+    EXPECT_DOUBLE_EQ(filter.add(20.0), 20.0);
+    EXPECT_DOUBLE_EQ(filter.add(70.0), 30.0);
+    
+    for (int i = 0; i < 100; ++i) filter.add(70.0);
+    EXPECT_NEAR(filter.value(), 70.0, 1e-6);
+}
+
+TEST_F(MoistureFilterTest, MedianRejectsSingleSpike) {
+    MoistureFilter filter(FilterKind::MEDIAN, 5);
+    for (double m : {40.0, 41.0, 0.0, 42.0, 40.5}) filter.add(m);
+    
+    EXPECT_NEAR(filter.value(), 40.5, MoistureFilter::RESOLUTION);
+}
+
+TEST_F(MoistureFilterTest, MedianOfEvenCountAveragesMiddlePair) {
+    MoistureFilter filter(FilterKind::MEDIAN, 10);
+    for (double m : {10.0, 20.0, 30.0, 40.0}) filter.add(m);
+    
+    EXPECT_NEAR(filter.value(), 25.0, MoistureFilter::RESOLUTION);
+}
+
+TEST_F(MoistureFilterTest, MedianSlidesWithWindow) {
+    MoistureFilter filter(FilterKind::MEDIAN, 3);
+    for (double m : {10.0, 10.0, 10.0, 50.0, 50.0}) filter.add(m);
+    
+    EXPECT_NEAR(filter.value(), 50.0, MoistureFilter::RESOLUTION);
+    EXPECT_EQ(filter.count(), 3u);
+}
+
+TEST_F(MoistureFilterTest, HampelPassesNormalSamplesAndReplacesOutliers) {
+    MoistureFilter filter(FilterKind::HAMPEL, 7);
+    for (double m : {40.0, 40.4, 39.8, 40.2, 39.9, 40.1}) filter.add(m);
+    
+    EXPECT_DOUBLE_EQ(filter.add(40.3), 40.3);           // within noise, passed through
+    EXPECT_NEAR(filter.add(5.0), 40.1, 0.2);            // spike, replaced by the median
+}
+
+TEST_F(MoistureFilterTest, HampelFollowsRealStepChange) {
+    MoistureFilter filter(FilterKind::HAMPEL, 5);
+    for (int i = 0; i < 5; ++i) filter.add(30.0);
+    for (int i = 0; i < 5; ++i) filter.add(60.0);
+    
+    EXPECT_DOUBLE_EQ(filter.value(), 60.0);
+}
+
+TEST_F(MoistureFilterTest, LargeWindowMedian) {
+    MoistureFilter filter(FilterKind::MEDIAN, 5000);
+    for (int i = 0; i < 20000; ++i) filter.add(static_cast<double>(i % 101));
+    
+    EXPECT_NEAR(filter.value(), 50.0, 1.0);
+}
@@ -0,0 +1,63 @@
+// tests/unit/test_mpsc_queue.cpp
+#include <gtest/gtest.h>
+#include "mpsc_queue.hpp"
+#include <thread>
+#include <vector>
+
+// Test Suite: Lock-free command queue
+class MpscQueueTest : public ::testing::Test {};
+
+TEST_F(MpscQueueTest, PopsInPushOrder) {
+    MpscQueue<int, 8> queue;
+    EXPECT_FALSE(queue.hasPending());
+    for (int i = 0; i < 5; ++i) EXPECT_TRUE(queue.tryPush(i));
+    EXPECT_TRUE(queue.hasPending());
+    
+    int value;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+    EXPECT_FALSE(queue.hasPending());
+}
+
+TEST_F(MpscQueueTest, PushFailsWhenFull) {
+    MpscQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(queue.tryPush(i));
+    EXPECT_FALSE(queue.tryPush(99));
+    
+    int value;
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_TRUE(queue.tryPush(4));  // Wraps around into the freed cell
+}
+
+TEST_F(MpscQueueTest, ConcurrentProducersDeliverEverythingInPerProducerOrder) {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 20000;
+    MpscQueue<std::pair<int, int>, 256> queue;
+    
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < PER_PRODUCER; ++i)
+                while (!queue.tryPush({p, i})) std::this_thread::yield();
+        });
+    }
+    
+    std::vector<int> next(PRODUCERS, 0);
+    int received = 0;
+    std::pair<int, int> item;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        if (!queue.tryPop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        EXPECT_EQ(item.second, next[item.first]);
+        next[item.first] = item.second + 1;
+        received++;
+    }
+    for (auto& t : producers) t.join();
+    
+    for (int p = 0; p < PRODUCERS; ++p) EXPECT_EQ(next[p], PER_PRODUCER);
+}
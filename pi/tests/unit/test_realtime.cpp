@@ -0,0 +1,49 @@
+// tests/unit/test_realtime.cpp
+#include <gtest/gtest.h>
+#include "realtime.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+
+// Test Suite: Real-time thread setup (only the steps that need no privileges)
+class RealtimeThreadTest : public ::testing::Test {};
+
+TEST_F(RealtimeThreadTest, NoOptionsChangeNothing) {
+    std::thread([]() {
+        RealtimeStatus status = RealtimeThread::configure(RealtimeOptions{});
+        EXPECT_FALSE(status.scheduled);
+        EXPECT_FALSE(status.pinned);
+        EXPECT_FALSE(status.memoryLocked);
+        EXPECT_FALSE(status.stackPrefaulted);
+        EXPECT_EQ(sched_getscheduler(0), SCHED_OTHER);
+    }).join();
+}
+
+TEST_F(RealtimeThreadTest, PinsToAnAllowedCpuAndPrefaultsStack) {
+    std::thread([]() {
+        cpu_set_t allowed;
+        ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(allowed), &allowed), 0);
+        int cpu = 0;
+        while (!CPU_ISSET(cpu, &allowed)) ++cpu;
+        
+        RealtimeOptions options;
+        options.cpu = cpu;
+        options.stackPrefaultBytes = 64 * 1024;
+        RealtimeStatus status = RealtimeThread::configure(options);
+        
+        EXPECT_TRUE(status.pinned);
+        EXPECT_TRUE(status.stackPrefaulted);
+        cpu_set_t now;
+        ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(now), &now), 0);
+        EXPECT_EQ(CPU_COUNT(&now), 1);
+        EXPECT_TRUE(CPU_ISSET(cpu, &now));
+    }).join();
+}
+
+TEST_F(RealtimeThreadTest, DefaultsAreRealtime) {
+    RealtimeOptions options = RealtimeThread::defaults();
+    EXPECT_GT(options.priority, 0);
+    EXPECT_GE(options.cpu, 0);
+    EXPECT_TRUE(options.lockMemory);
+    EXPECT_GT(options.stackPrefaultBytes, 0u);
+}
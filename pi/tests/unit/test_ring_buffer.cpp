@@ -0,0 +1,60 @@
+// tests/unit/test_ring_buffer.cpp
+#include <gtest/gtest.h>
+#include "ring_buffer.hpp"
+#include <vector>
+
+// Test Suite: Contiguous fixed-capacity history
+class RingBufferTest : public ::testing::Test {
+protected:
+    static std::vector<int> contents(const RingBuffer<int>& buffer) {
+        auto view = buffer.view();
+        return std::vector<int>(view.begin(), view.end());
+    }
+};
+
+TEST_F(RingBufferTest, StartsEmpty) {
+    RingBuffer<int> buffer(4);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.view().size(), 0u);
+}
+
+TEST_F(RingBufferTest, KeepsOldestFirstUntilFull) {
+    RingBuffer<int> buffer(4);
+    buffer.push(1);
+    buffer.push(2);
+    buffer.push(3);
+    
+    EXPECT_EQ(contents(buffer), (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(buffer.back(), 3);
+}
+
+TEST_F(RingBufferTest, DropsOldestAndStaysContiguousAfterWrap) {
+    RingBuffer<int> buffer(4);
+    for (int i = 1; i <= 11; ++i) buffer.push(i);
+    
+    EXPECT_EQ(buffer.size(), 4u);
+    EXPECT_EQ(contents(buffer), (std::vector<int>{8, 9, 10, 11}));
+    EXPECT_EQ(buffer.back(), 11);
+}
+
+TEST_F(RingBufferTest, ResizeKeepsNewestElements) {
+    RingBuffer<int> buffer(4);
+    for (int i = 1; i <= 6; ++i) buffer.push(i);
+    
+    buffer.resize(2);
+    EXPECT_EQ(contents(buffer), (std::vector<int>{5, 6}));
+    
+    buffer.resize(8);
+    buffer.push(7);
+    EXPECT_EQ(contents(buffer), (std::vector<int>{5, 6, 7}));
+}
+
+TEST_F(RingBufferTest, LargeWindowHoldsThousandsOfSamples) {
+    RingBuffer<int> buffer(5000);
+    for (int i = 0; i < 12345; ++i) buffer.push(i);
+    
+    auto view = buffer.view();
+    ASSERT_EQ(view.size(), 5000u);
+    EXPECT_EQ(view.front(), 12345 - 5000);
+    EXPECT_EQ(view.back(), 12344);
+}
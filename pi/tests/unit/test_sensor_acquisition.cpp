@@ -0,0 +1,149 @@
+// tests/unit/test_sensor_acquisition.cpp
+#include <gtest/gtest.h>
+#include "sensor_acquisition.hpp"
+#include "test_fixtures.hpp"
+#include <atomic>
+#include <thread>
+
+using ::testing::Return;
+
+namespace {
+// Sensor whose every channel read takes a while, counts batched reads
+class SlowSensor : public ISensorInterface {
+public:
+    explicit SlowSensor(std::chrono::microseconds latency) : latency(latency) {}
+
+    bool initialize() override { return true; }
+    double getMoisture() override { return moisture.load(); }
+    double getTemp() override { return 24.0; }
+    double getHumid() override { return 55.0; }
+    bool isRainDetected() override { return false; }
+    bool isHealthy() override { return true; }
+    SensorFrame readAll() override {
+        std::this_thread::sleep_for(latency);
+        ++reads;
+        return readEachChannel(std::chrono::steady_clock::now());
+    }
+
+    std::atomic<double> moisture{40.0};
+    std::atomic<int> reads{0};
+
+private:
+    std::chrono::microseconds latency;
+};
+
+template <typename Predicate>
+bool waitFor(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+}
+
+// Test Suite: Sensor acquisition thread
+class SensorAcquisitionTest : public ::testing::Test {};
+
+TEST_F(SensorAcquisitionTest, PublishesFramesAtItsOwnRate) {
+    SlowSensor sensor(std::chrono::microseconds(100));
+    SensorAcquisition acquisition(&sensor, std::chrono::milliseconds(2));
+    acquisition.start();
+    
+    ASSERT_TRUE(waitFor([&]() { return acquisition.frameCount() >= 5; }));
+    // stopped first, so no frame can be published after the one taken below
+    acquisition.stop();
+    
+    SensorFrame frame;
+    ASSERT_TRUE(acquisition.latest(frame));
+    EXPECT_DOUBLE_EQ(frame.moisture, 40.0);
+    EXPECT_TRUE(frame.moistureValid);
+    
+    // every frame is either taken or counted as dropped
+    EXPECT_EQ(acquisition.droppedCount() + 1, acquisition.frameCount());
+}
+
+TEST_F(SensorAcquisitionTest, CountsStaleReadsWithoutBlocking) {
+    SlowSensor sensor(std::chrono::microseconds(0));
+    SensorAcquisition acquisition(&sensor, std::chrono::milliseconds(1000));
+    acquisition.start();
+    ASSERT_TRUE(waitFor([&]() { return acquisition.frameCount() >= 1; }));
+    
+    SensorFrame frame;
+    EXPECT_TRUE(acquisition.latest(frame));
+    EXPECT_FALSE(acquisition.latest(frame));
+    EXPECT_FALSE(acquisition.latest(frame));
+    EXPECT_EQ(acquisition.staleCount(), 2u);
+}
+
+TEST_F(SensorAcquisitionTest, StopIsPromptAndRepeatable) {
+    SlowSensor sensor(std::chrono::microseconds(0));
+    SensorAcquisition acquisition(&sensor, std::chrono::seconds(30));
+    acquisition.start();
+    ASSERT_TRUE(waitFor([&]() { return acquisition.frameCount() >= 1; }));
+    
+    auto before = std::chrono::steady_clock::now();
+    acquisition.stop();
+    acquisition.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - before, std::chrono::seconds(1));
+}
+
+// Test Suite: State machine fed by the acquisition thread
+class AcquisitionStateMachineTest : public StateMachineTestFixture {};
+
+TEST_F(AcquisitionStateMachineTest, ControlTickNeverReadsTheSensor) {
+    SlowSensor slowSensor(std::chrono::microseconds(200));
+    SensorAcquisition acquisition(&slowSensor, std::chrono::milliseconds(1));
+    auto sm = std::make_unique<StateMachine>(&slowSensor, &mockPump, config, &clock);
+    sm->attachAcquisition(&acquisition);
+    acquisition.start();
+    ASSERT_TRUE(waitFor([&]() { return acquisition.frameCount() >= 1; }));
+    
+    sm->sendCommnd(Command::START_AUTO);
+    sm->update();  // first tick takes the first frame
+    acquisition.stop();
+    sm->update();  // picks up whatever arrived before the stop
+    int readsBefore = slowSensor.reads.load();
+    auto staleBefore = acquisition.staleCount();
+    
+    // with the thread stopped no new frames arrive, ticks still run and reuse the last one
+    for (int i = 0; i < 5; ++i) sm->update();
+    EXPECT_EQ(slowSensor.reads.load(), readsBefore);
+    EXPECT_EQ(sm->getCurrentState(), SystemState::MONITORING);
+    EXPECT_DOUBLE_EQ(sm->getStatus().moisture, 40.0);
+    EXPECT_EQ(acquisition.staleCount(), staleBefore + 5);
+}
+
+TEST_F(AcquisitionStateMachineTest, DebounceCountsSamplesNotTicks) {
+    SlowSensor slowSensor(std::chrono::microseconds(0));
+    slowSensor.moisture = 10.0;  // one dry sample, the next one is a minute away
+    SensorAcquisition acquisition(&slowSensor, std::chrono::seconds(60));
+    auto sm = std::make_unique<StateMachine>(&slowSensor, &mockPump, config, &clock);
+    sm->attachAcquisition(&acquisition);
+    acquisition.start();
+    ASSERT_TRUE(waitFor([&]() { return acquisition.frameCount() >= 1; }));
+    advanceTime(3600);  // well past the minimum watering interval
+    
+    sm->sendCommnd(Command::START_AUTO);
+    for (int i = 0; i < 10; ++i) sm->update();
+    
+    EXPECT_EQ(sm->getCurrentState(), SystemState::MONITORING);
+    acquisition.stop();
+}
+
+TEST_F(AcquisitionStateMachineTest, OneInvalidSampleIsOneFailure) {
+    SlowSensor slowSensor(std::chrono::microseconds(0));
+    slowSensor.moisture = -50.0;  // out of range
+    SensorAcquisition acquisition(&slowSensor, std::chrono::seconds(60));
+    auto sm = std::make_unique<StateMachine>(&slowSensor, &mockPump, config, &clock);
+    sm->attachAcquisition(&acquisition);
+    acquisition.start();
+    ASSERT_TRUE(waitFor([&]() { return acquisition.frameCount() >= 1; }));
+    
+    sm->sendCommnd(Command::START_AUTO);
+    for (int i = 0; i < 10; ++i) sm->update();
+    
+    EXPECT_EQ(sm->getCurrentState(), SystemState::MONITORING);
+    acquisition.stop();
+}
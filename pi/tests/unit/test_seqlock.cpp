@@ -0,0 +1,66 @@
+// tests/unit/test_seqlock.cpp
+#include <gtest/gtest.h>
+#include "seqlock.hpp"
+#include <atomic>
+#include <thread>
+
+// Test Suite: Single-writer seqlock
+class SeqLockTest : public ::testing::Test {
+protected:
+    struct Tuple {
+        double a;
+        double b;
+        std::uint64_t sum;  // a + b, checked by readers
+        bool flag;
+    };
+};
+
+TEST_F(SeqLockTest, StartsWithDefaultValue) {
+    SeqLock<Tuple> lock;
+    Tuple value = lock.load();
+    
+    EXPECT_DOUBLE_EQ(value.a, 0.0);
+    EXPECT_FALSE(value.flag);
+    EXPECT_EQ(lock.version(), 1u);
+}
+
+TEST_F(SeqLockTest, LoadReturnsLastStore) {
+    SeqLock<Tuple> lock;
+    lock.store({1.5, 2.5, 4, true});
+    lock.store({3.0, 4.0, 7, false});
+    
+    Tuple value = lock.load();
+    EXPECT_DOUBLE_EQ(value.a, 3.0);
+    EXPECT_DOUBLE_EQ(value.b, 4.0);
+    EXPECT_EQ(value.sum, 7u);
+    EXPECT_FALSE(value.flag);
+    EXPECT_EQ(lock.version(), 3u);
+    
+    std::uint64_t version = 0;
+    EXPECT_EQ(lock.load(version).sum, 7u);
+    EXPECT_EQ(version, 3u);
+}
+
+TEST_F(SeqLockTest, ReadersNeverSeeTornValues) {
+    SeqLock<Tuple> lock;
+    lock.store({0.0, 0.0, 0, true});  // the default value does not satisfy the checks below
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    
+    std::thread reader([&]() {
+        while (!done.load()) {
+            Tuple value = lock.load();
+            if (static_cast<std::uint64_t>(value.a + value.b) != value.sum) ++torn;
+            if (value.flag != (value.sum % 2 == 0)) ++torn;
+        }
+    });
+    
+    for (std::uint64_t i = 0; i < 200000; ++i) {
+        lock.store({static_cast<double>(i), static_cast<double>(i * 2), i * 3, (i * 3) % 2 == 0});
+        if (i % 64 == 0) std::this_thread::yield();
+    }
+    done = true;
+    reader.join();
+    
+    EXPECT_EQ(torn.load(), 0);
+}
@@ -0,0 +1,103 @@
+// tests/unit/test_simulated_hardware.cpp
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include "simulated_hardware.hpp"
+#include "clock.hpp"
+#include "blocked_sink.hpp"
+#include <atomic>
+#include <thread>
+
+// Test Suite: Simulator physics driven by a virtual clock
+class SimulatedHardwareTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spdlog::set_level(spdlog::level::warn); // PHYSICS logs once per simulated second
+    }
+
+    void TearDown() override {
+        spdlog::set_level(spdlog::level::info);
+    }
+
+    // Advance simulated time in fixed steps, calling update() like the main loop does
+    void runFor(std::chrono::seconds duration, std::chrono::seconds step = std::chrono::seconds(1)) {
+        for (auto elapsed = std::chrono::seconds(0); elapsed < duration; elapsed += step) {
+            clock.advance(step);
+            sim.update();
+        }
+    }
+
+    VirtualClock clock;
+    SimulatedHardware sim{&clock};
+};
+
+TEST_F(SimulatedHardwareTest, NoTimePassesWithoutClockAdvance) {
+    double before = sim.getMoisture();
+    sim.update();
+    EXPECT_NEAR(sim.getMoisture(), before, 1.0);  // Only sensor noise, no physics
+}
+
+TEST_F(SimulatedHardwareTest, SoilDriesOverSimulatedDay) {
+    double before = sim.getMoisture();
+    
+    runFor(std::chrono::hours(24), std::chrono::seconds(10));
+    
+    EXPECT_LT(sim.getMoisture(), before);
+}
+
+TEST_F(SimulatedHardwareTest, PumpRaisesMoisture) {
+    sim.setScenario(SimulatedHardware::Scenario::DRY);
+    double before = sim.getMoisture();
+    
+    sim.activate();
+    runFor(std::chrono::seconds(30));
+    
+    EXPECT_GT(sim.getMoisture(), before + 10.0);
+}
+
+TEST_F(SimulatedHardwareTest, ReadAllMatchesSingleChannelReads) {
+    runFor(std::chrono::minutes(5));
+    SensorFrame frame = sim.readAll();
+    
+    EXPECT_DOUBLE_EQ(frame.moisture, sim.getMoisture());
+    EXPECT_DOUBLE_EQ(frame.temperature, sim.getTemp());
+    EXPECT_DOUBLE_EQ(frame.humidity, sim.getHumid());
+    EXPECT_EQ(frame.rainDetected, sim.isRainDetected());
+    EXPECT_TRUE(frame.healthy);
+    EXPECT_TRUE(frame.moistureValid);
+    EXPECT_TRUE(frame.temperatureValid);
+    EXPECT_TRUE(frame.humidityValid);
+    EXPECT_EQ(frame.timeStamp, clock.now());
+}
+
+TEST_F(SimulatedHardwareTest, BlockedLoggerDoesNotHoldUpThePump) {
+    auto sink = std::make_shared<BlockedSink>();
+    auto previous = spdlog::default_logger();
+    auto blocked = std::make_shared<spdlog::logger>("blocked", sink);
+    blocked->set_level(spdlog::level::trace);
+    spdlog::set_default_logger(blocked);
+    sim.activate();
+    
+    // the physics thread gets stuck in its once-per-second log line
+    clock.advance(std::chrono::seconds(2));
+    std::thread physics([this]() { sim.update(); });
+    ASSERT_TRUE(sink->waitForEntry(std::chrono::seconds(1)));
+    
+    std::atomic<bool> done{false};
+    std::atomic<bool> pumpOff{false};
+    std::thread cutOff([&]() {
+        sim.deactivate();
+        pumpOff = !sim.isActive();
+        sim.readAll();
+        done = true;
+    });
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!done && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_TRUE(done.load());  // while the sink is still blocked
+    EXPECT_TRUE(pumpOff.load());
+    
+    sink->release();
+    physics.join();
+    cutOff.join();
+    spdlog::set_default_logger(previous);
+}
@@ -0,0 +1,88 @@
+// tests/unit/test_slope_estimator.cpp
+#include <gtest/gtest.h>
+#include "slope_estimator.hpp"
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+// Test Suite: Running least-squares slope
+class SlopeEstimatorTest : public ::testing::Test {
+protected:
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::time_point{} + 1h;
+};
+
+TEST_F(SlopeEstimatorTest, NeedsTwoSamplesSpreadOverTime) {
+    SlopeEstimator estimator(10);
+    EXPECT_FALSE(estimator.slope().has_value());
+    
+    estimator.add(start, 30.0);
+    EXPECT_FALSE(estimator.slope().has_value());
+    
+    estimator.add(start, 31.0);  // same instant, no time spread yet
+    EXPECT_FALSE(estimator.slope().has_value());
+    EXPECT_EQ(estimator.count(), 2u);
+}
+
+TEST_F(SlopeEstimatorTest, ResolvesSubSecondSampling) {
+    SlopeEstimator estimator(20);
+    
+    // 0.01% every 100ms is 6%/min
+    for (int i = 0; i < 20; ++i)
+        estimator.add(start + i * 100ms, 30.0 + i * 0.01);
+    
+    ASSERT_TRUE(estimator.slope().has_value());
+    EXPECT_NEAR(estimator.slope().value(), 6.0, 1e-9);
+    EXPECT_NEAR(estimator.rSquared(), 1.0, 1e-9);
+}
+
+TEST_F(SlopeEstimatorTest, NoiseLowersFitQualityNotTrend) {
+    SlopeEstimator estimator(50);
+    
+    // 1%/min with alternating +-0.5% noise
+    for (int i = 0; i < 50; ++i)
+        estimator.add(start + i * 1s, 40.0 + i / 60.0 + (i % 2 ? 0.5 : -0.5));
+    
+    ASSERT_TRUE(estimator.slope().has_value());
+    EXPECT_NEAR(estimator.slope().value(), 1.0, 0.1);
+    EXPECT_LT(estimator.rSquared(), 0.9);
+}
+
+TEST_F(SlopeEstimatorTest, FlatSeriesHasZeroSlope) {
+    SlopeEstimator estimator(10);
+    for (int i = 0; i < 10; ++i) estimator.add(start + i * 1s, 20.0);
+    
+    EXPECT_NEAR(estimator.slope().value(), 0.0, 1e-12);
+    EXPECT_DOUBLE_EQ(estimator.rSquared(), 1.0);
+}
+
+TEST_F(SlopeEstimatorTest, WindowForgetsOldTrend) {
+    SlopeEstimator estimator(10);
+    
+    // falling, then rising once the window has rolled over
+    for (int i = 0; i < 10; ++i) estimator.add(start + i * 1s, 50.0 - i);
+    for (int i = 10; i < 20; ++i) estimator.add(start + i * 1s, 40.0 + (i - 10) * 0.5);
+    
+    EXPECT_EQ(estimator.count(), 10u);
+    EXPECT_NEAR(estimator.slope().value(), 30.0, 1e-6);
+}
+
+TEST_F(SlopeEstimatorTest, StaysAccurateOverLongRuns) {
+    SlopeEstimator estimator(100);
+    
+    // a day of 100ms ticks, 2%/min
+    for (int i = 0; i < 864000; ++i)
+        estimator.add(start + i * 100ms, 10.0 + i * (2.0 / 600.0));
+    
+    EXPECT_NEAR(estimator.slope().value(), 2.0, 1e-6);
+}
+
+TEST_F(SlopeEstimatorTest, ResetClearsSamples) {
+    SlopeEstimator estimator(10);
+    estimator.add(start, 10.0);
+    estimator.add(start + 1s, 20.0);
+    
+    estimator.reset();
+    
+    EXPECT_EQ(estimator.count(), 0u);
+    EXPECT_FALSE(estimator.slope().has_value());
+}
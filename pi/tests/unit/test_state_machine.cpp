@@ -1,6 +1,7 @@
 // tests/unit/test_state_machine.cpp
 #include <gtest/gtest.h>
 #include "test_fixtures.hpp"
+#include <functional>
 
 using ::testing::Return;
 using ::testing::_;
@@ -32,6 +33,20 @@ TEST_F(StateMachineInitTest, PumpIsOffOnStartup) {
 // Test Suite: Command Processing
 class CommandProcessingTest : public StateMachineTestFixture {};
 
+// plain pump that can run a hook just before it switches on
+class PumpStub : public IPumpInterface {
+public:
+    bool initialize() override { return true; }
+    void activate() override {
+        if (beforeSwitchOn) std::exchange(beforeSwitchOn, nullptr)();
+        running = true;
+    }
+    void deactivate() override { running = false; }
+    bool isActive() override { return running; }
+    std::function<void()> beforeSwitchOn;
+    bool running = false;
+};
+
 TEST_F(CommandProcessingTest, StartAutoTransitionsToMonitoring) {
     auto sm = createStateMachine();
     
@@ -64,6 +79,48 @@ TEST_F(CommandProcessingTest, EmergencyStopGoesToError) {
     EXPECT_EQ(sm->getCurrentState(), SystemState::ERROR);
 }
 
+TEST_F(CommandProcessingTest, EmergencyStopCutsPumpOnCallingThread) {
+    auto sm = createStateMachine();
+    sm->sendCommnd(Command::START_AUTO);
+    sm->update();
+    
+    EXPECT_CALL(mockPump, deactivate()).Times(1);
+    sm->emergencyStop();
+    ::testing::Mock::VerifyAndClearExpectations(&mockPump);
+    EXPECT_TRUE(sm->emergencyStopPending());
+    EXPECT_EQ(sm->getCurrentState(), SystemState::MONITORING);
+    
+    sm->update();
+    EXPECT_FALSE(sm->emergencyStopPending());
+    EXPECT_EQ(sm->getCurrentState(), SystemState::ERROR);
+}
+
+TEST_F(CommandProcessingTest, EmergencyStopBeatsQueuedCommands) {
+    PumpStub pump;
+    StateMachine sm(&mockSensor, &pump, config, &clock);
+    
+    sm.sendCommnd(Command::ENABLE_MANUAL);  // switches the pump on while draining
+    sm.emergencyStop();
+    sm.update();
+    
+    EXPECT_FALSE(pump.isActive());
+    EXPECT_EQ(sm.getCurrentState(), SystemState::ERROR);
+    EXPECT_FALSE(sm.getStatus().pumpActive);
+}
+
+TEST_F(CommandProcessingTest, StopLandingDuringPumpStartIsNotLost) {
+    PumpStub pump;
+    StateMachine sm(&mockSensor, &pump, config, &clock);
+    // the stop is handled between the control thread's activate call and the relay switching
+    pump.beforeSwitchOn = [&]() { sm.emergencyStop(); };
+    
+    sm.sendCommnd(Command::ENABLE_MANUAL);
+    sm.update();
+    
+    EXPECT_FALSE(pump.isActive());
+    EXPECT_EQ(sm.getCurrentState(), SystemState::ERROR);
+}
+
 TEST_F(CommandProcessingTest, MultipleCommandsProcessedInOrder) {
     auto sm = createStateMachine();
     
@@ -77,6 +134,19 @@ TEST_F(CommandProcessingTest, MultipleCommandsProcessedInOrder) {
     EXPECT_EQ(sm->getCurrentState(), SystemState::MANUAL);
 }
 
+TEST_F(CommandProcessingTest, RejectsCommandsWhenQueueFull) {
+    auto sm = createStateMachine();
+    
+    int accepted = 0;
+    while (sm->sendCommnd(Command::START_AUTO) && accepted < 1000) accepted++;
+    
+    EXPECT_EQ(accepted, 64);
+    sm->update();  // Drain frees the queue again
+    EXPECT_TRUE(sm->sendCommnd(Command::ENABLE_MANUAL));
+    sm->update();
+    EXPECT_EQ(sm->getCurrentState(), SystemState::MANUAL);
+}
+
 // Test Suite: IDLE State Behavior
 class IdleStateTest : public StateMachineTestFixture {};
 
@@ -118,6 +188,18 @@ TEST_F(IdleStateTest, StaysIdleWhenRaining) {
     EXPECT_EQ(sm->getCurrentState(), SystemState::IDLE);  // Still idle
 }
 
+TEST_F(IdleStateTest, AutoStartsMonitoringAfterStablePeriod) {
+    auto sm = createStateMachine();
+    
+    sm->update();
+    EXPECT_EQ(sm->getCurrentState(), SystemState::IDLE);
+    
+    advanceTime(30);
+    sm->update();
+    
+    EXPECT_EQ(sm->getCurrentState(), SystemState::MONITORING);
+}
+
 // Test Suite: MONITORING State
 class MonitoringStateTest : public StateMachineTestFixture {};
 
@@ -159,6 +241,23 @@ TEST_F(MonitoringStateTest, DoesNotWaterIfIntervalTooShort) {
     EXPECT_EQ(sm->getCurrentState(), SystemState::MONITORING);
 }
 
+TEST_F(MonitoringStateTest, WatersOnceIntervalElapsed) {
+    config.minWateringIntervalMinutes = 45;
+    auto sm = createStateMachine();
+    
+    EXPECT_CALL(mockSensor, getMoisture())
+        .WillRepeatedly(Return(20.0));
+
+    sm->sendCommnd(Command::START_AUTO);
+    for (int i = 0; i < 5; ++i) sm->update();
+    EXPECT_EQ(sm->getCurrentState(), SystemState::MONITORING);
+    
+    advanceTime(45 * 60);
+    sm->update();
+    
+    EXPECT_EQ(sm->getCurrentState(), SystemState::WATERING);
+}
+
 TEST_F(MonitoringStateTest, ResetsLowReadingCounterWhenMoistureNormal) {
     config.minWateringIntervalMinutes = 0;
     auto sm = createStateMachine();
@@ -196,6 +295,88 @@ TEST_F(MonitoringStateTest, ResetsLowReadingCounterWhenMoistureNormal) {
     EXPECT_EQ(sm->getCurrentState(), SystemState::WATERING);
 }
 
+TEST_F(MonitoringStateTest, MedianFilterIgnoresDropoutSpikes) {
+    config.minWateringIntervalMinutes = 0;
+    config.filterKind = FilterKind::MEDIAN;
+    auto sm = createStateMachine();
+    
+    // Every third reading drops out to 0, the median never sees it
+    int call = 0;
+    EXPECT_CALL(mockSensor, getMoisture())
+        .WillRepeatedly(::testing::Invoke([&call]() { return ++call % 3 == 0 ? 0.0 : 35.0; }));
+
+    sm->sendCommnd(Command::START_AUTO);
+    for (int i = 0; i < 30; ++i) sm->update();
+    
+    EXPECT_EQ(sm->getCurrentState(), SystemState::MONITORING);
+}
+
+TEST_F(MonitoringStateTest, MovingAverageIsPulledDownByDropoutSpikes) {
+    config.minWateringIntervalMinutes = 0;
+    auto sm = createStateMachine();
+    
+    int call = 0;
+    EXPECT_CALL(mockSensor, getMoisture())
+        .WillRepeatedly(::testing::Invoke([&call]() { return ++call % 3 == 0 ? 0.0 : 35.0; }));
+
+    sm->sendCommnd(Command::START_AUTO);
+    for (int i = 0; i < 30; ++i) sm->update();
+    
+    EXPECT_EQ(sm->getCurrentState(), SystemState::WATERING);
+}
+
+TEST_F(MonitoringStateTest, ConfigUpdateAppliedOnNextTick) {
+    config.minWateringIntervalMinutes = 0;
+    auto sm = createStateMachine();
+    
+    EXPECT_CALL(mockSensor, getMoisture())
+        .WillRepeatedly(Return(35.0));  // fine for the default threshold
+
+    sm->sendCommnd(Command::START_AUTO);
+    for (int i = 0; i < 5; ++i) sm->update();
+    EXPECT_EQ(sm->getCurrentState(), SystemState::MONITORING);
+    
+    IrrigationConfig drier = config;
+    drier.lowMoistureThreshold = 40.0;
+    sm->updateConfig(drier);
+    EXPECT_DOUBLE_EQ(sm->getConfig().lowMoistureThreshold, 40.0);
+    
+    for (int i = 0; i < 4; ++i) sm->update();
+    EXPECT_EQ(sm->getCurrentState(), SystemState::WATERING);
+}
+
+TEST_F(MonitoringStateTest, StatusSnapshotReflectsLastTick) {
+    config.minWateringIntervalMinutes = 0;
+    auto sm = createStateMachine();
+    
+    ON_CALL(mockSensor, getMoisture()).WillByDefault(Return(42.0));
+    ON_CALL(mockSensor, getTemp()).WillByDefault(Return(21.5));
+    ON_CALL(mockSensor, isRainDetected()).WillByDefault(Return(true));
+    
+    sm->sendCommnd(Command::START_AUTO);
+    sm->update();
+    sm->update();
+    
+    StatusSnapshot status = sm->getStatus();
+    EXPECT_EQ(status.state, SystemState::MONITORING);
+    EXPECT_EQ(status.tick, 2u);
+    EXPECT_DOUBLE_EQ(status.moisture, 42.0);
+    EXPECT_DOUBLE_EQ(status.filteredMoisture, 42.0);
+    EXPECT_DOUBLE_EQ(status.temperature, 21.5);
+    EXPECT_TRUE(status.rainDetected);
+    EXPECT_FALSE(status.pumpActive);
+    EXPECT_EQ(status.timeStamp, clock.now());
+}
+
+TEST_F(MonitoringStateTest, ReadsOneSensorFramePerTick) {
+    auto sm = createStateMachine();
+    
+    EXPECT_CALL(mockSensor, readAll()).Times(3);
+    
+    sm->sendCommnd(Command::START_AUTO);
+    for (int i = 0; i < 3; ++i) sm->update();
+}
+
 // Test Suite: WATERING State
 class WateringStateTest : public StateMachineTestFixture {};
 
@@ -263,14 +444,241 @@ TEST_F(WateringStateTest, StopsOnTimeout) {
     EXPECT_CALL(mockPump, isActive()).WillRepeatedly(Return(true));
     EXPECT_CALL(mockPump, deactivate()).Times(AtLeast(1));
     
-    // Wait for timeout (1.5 seconds > 1 second limit)
-    advanceTime(150);
+    // Wait for timeout (2 seconds > 1 second limit)
+    advanceTime(2);
     // Flush to ensure timeout is processed
     for(int i=0; i<3; i++) sm->update();
     
     EXPECT_EQ(sm->getCurrentState(), SystemState::ERROR);  // Timeout error
 }
 
+TEST_F(WateringStateTest, DetectsPumpFailureFromFlatTrend) {
+    config.minWateringIntervalMinutes = 0;
+    auto sm = createStateMachine();
+    
+    EXPECT_CALL(mockSensor, getMoisture())
+        .WillRepeatedly(Return(20.0));  // pump runs but soil stays dry
+
+    sm->sendCommnd(Command::START_AUTO);
+    for (int i = 0; i < 4; ++i) sm->update();
+    ASSERT_EQ(sm->getCurrentState(), SystemState::WATERING);
+    
+    EXPECT_CALL(mockPump, isActive()).WillRepeatedly(Return(true));
+    EXPECT_CALL(mockPump, deactivate()).Times(1);
+    
+    // one reading per second, the check starts after 10s of watering
+    for (int i = 0; i < 12 && sm->getCurrentState() == SystemState::WATERING; ++i) {
+        advanceTime(1);
+        sm->update();
+    }
+    
+    EXPECT_EQ(sm->getCurrentState(), SystemState::ERROR);
+}
+
+TEST_F(WateringStateTest, KeepsWateringWhileMoistureRises) {
+    config.minWateringIntervalMinutes = 0;
+    auto sm = createStateMachine();
+    
+    double moisture = 20.0;
+    EXPECT_CALL(mockSensor, getMoisture())
+        .WillRepeatedly([&moisture]() { return moisture; });
+
+    sm->sendCommnd(Command::START_AUTO);
+    for (int i = 0; i < 4; ++i) sm->update();
+    ASSERT_EQ(sm->getCurrentState(), SystemState::WATERING);
+    
+    EXPECT_CALL(mockPump, isActive()).WillRepeatedly(Return(true));
+    
+    // +0.1% per second is 6%/min, well above the failure limit
+    for (int i = 0; i < 20; ++i) {
+        moisture += 0.1;
+        advanceTime(1);
+        sm->update();
+    }
+    
+    EXPECT_EQ(sm->getCurrentState(), SystemState::WATERING);
+}
+
+// Test Suite: WAITING State
+class WaitingStateTest : public StateMachineTestFixture {};
+
+TEST_F(WaitingStateTest, ResumesMonitoringAfterWaitPeriod) {
+    config.minWateringIntervalMinutes = 0;
+    config.waitMinutes = 15;
+    auto sm = createStateMachine();
+    
+    EXPECT_CALL(mockSensor, getMoisture())
+        .WillOnce(Return(20))   // Start
+        .WillOnce(Return(20))   // Low 1
+        .WillOnce(Return(20))   // Low 2
+        .WillOnce(Return(20))   // Low 3 -> Transition to WATERING
+        .WillRepeatedly(Return(100));  // target reached
+    EXPECT_CALL(mockPump, isActive()).WillRepeatedly(Return(true));
+
+    sm->sendCommnd(Command::START_AUTO);
+    for (int i = 0; i < 4; ++i) sm->update();
+    ASSERT_EQ(sm->getCurrentState(), SystemState::WATERING);
+    
+    for (int i = 0; i < 5; ++i) sm->update();
+    ASSERT_EQ(sm->getCurrentState(), SystemState::WAITING);
+    
+    advanceTime(14 * 60);
+    sm->update();
+    EXPECT_EQ(sm->getCurrentState(), SystemState::WAITING);
+    
+    advanceTime(60);
+    sm->update();
+    EXPECT_EQ(sm->getCurrentState(), SystemState::MONITORING);
+}
+
+// Test Suite: Next Deadline
+class NextDeadlineTest : public StateMachineTestFixture {};
+
+TEST_F(NextDeadlineTest, ActiveStatesTickAtSamplingPeriod) {
+    auto sm = createStateMachine();
+    sm->update();
+    
+    EXPECT_EQ(sm->nextDeadline(),
+              clock.now() + config.sampling[static_cast<std::size_t>(SystemState::IDLE)].period);
+}
+
+TEST_F(NextDeadlineTest, MonitoringBurstsOnEntryThenSlowsDown) {
+    config.sampling[static_cast<std::size_t>(SystemState::MONITORING)] = {std::chrono::seconds(2), 3};
+    auto sm = createStateMachine();
+    sm->sendCommnd(Command::START_AUTO);
+    sm->update();
+    ASSERT_EQ(sm->getCurrentState(), SystemState::MONITORING);
+    
+    for (int i = 1; i < 3; ++i) {
+        EXPECT_EQ(sm->nextDeadline(), clock.now() + StateMachine::TICK_PERIOD);
+        sm->update();
+    }
+    EXPECT_EQ(sm->nextDeadline(), clock.now() + std::chrono::seconds(2));
+}
+
+TEST_F(NextDeadlineTest, WateringSamplesFast) {
+    EXPECT_CALL(mockSensor, getMoisture()).WillRepeatedly(Return(20));
+    config.minWateringIntervalMinutes = 0;
+    auto sm = createStateMachine();
+    sm->sendCommnd(Command::START_AUTO);
+    for (int i = 0; i < 10 && sm->getCurrentState() != SystemState::WATERING; ++i) sm->update();
+    ASSERT_EQ(sm->getCurrentState(), SystemState::WATERING);
+    
+    EXPECT_EQ(sm->nextDeadline(),
+              clock.now() + config.sampling[static_cast<std::size_t>(SystemState::WATERING)].period);
+}
+
+TEST_F(NextDeadlineTest, PeriodNeverShorterThanTick) {
+    config.sampling[static_cast<std::size_t>(SystemState::IDLE)] = {std::chrono::milliseconds(1), 0};
+    auto sm = createStateMachine();
+    sm->update();
+    
+    EXPECT_EQ(sm->nextDeadline(), clock.now() + StateMachine::TICK_PERIOD);
+}
+
+TEST_F(NextDeadlineTest, WaitingSleepsUntilWaitPeriodEnds) {
+    config.minWateringIntervalMinutes = 0;
+    config.waitMinutes = 15;
+    auto sm = createStateMachine();
+    
+    EXPECT_CALL(mockSensor, getMoisture())
+        .WillOnce(Return(20))
+        .WillOnce(Return(20))
+        .WillOnce(Return(20))
+        .WillOnce(Return(20))
+        .WillRepeatedly(Return(100));
+    EXPECT_CALL(mockPump, isActive()).WillRepeatedly(Return(true));
+
+    sm->sendCommnd(Command::START_AUTO);
+    for (int i = 0; i < 9; ++i) sm->update();
+    ASSERT_EQ(sm->getCurrentState(), SystemState::WAITING);
+    
+    auto enteredWaiting = clock.now();
+    advanceTime(60);
+    EXPECT_EQ(sm->nextDeadline(), enteredWaiting + std::chrono::minutes(15));
+}
+
+TEST_F(NextDeadlineTest, ErrorSleepsUntilRecoveryInterval) {
+    auto sm = createStateMachine();
+    sm->sendCommnd(Command::EMERGENCY_STOP);
+    sm->update();
+    ASSERT_EQ(sm->getCurrentState(), SystemState::ERROR);
+    
+    EXPECT_EQ(sm->nextDeadline(),
+              clock.now() + std::chrono::seconds(StateMachine::ERROR_RECOVERY_SECONDS));
+}
+
+// Test Suite: Tick Context
+class TickContextTest : public StateMachineTestFixture {};
+
+// moves forward on every read, so any second now() in a tick would show
+class SteppingClock : public IClockInterface {
+public:
+    std::chrono::steady_clock::time_point now() override {
+        ++reads;
+        current += std::chrono::milliseconds(1);
+        return current;
+    }
+    std::chrono::steady_clock::time_point current{};
+    int reads = 0;
+};
+
+TEST_F(TickContextTest, ReadsTheClockOncePerTick) {
+    SteppingClock stepping;
+    StateMachine sm(&mockSensor, &mockPump, config, &stepping);
+    sm.sendCommnd(Command::START_AUTO);
+    sm.update();  // state change inside the tick
+    sm.update();
+    
+    int before = stepping.reads;
+    sm.update();
+    EXPECT_EQ(stepping.reads - before, 1);
+    EXPECT_EQ(sm.getStatus().timeStamp, stepping.current);
+}
+
+TEST_F(TickContextTest, StateEntryUsesTickTime) {
+    SteppingClock stepping;
+    StateMachine sm(&mockSensor, &mockPump, config, &stepping);
+    sm.sendCommnd(Command::EMERGENCY_STOP);
+    sm.update();
+    auto tickTime = sm.getStatus().timeStamp;
+    
+    // ERROR sleeps until entry + recovery interval, entry being the tick's own timestamp
+    auto deadline = sm.nextDeadline();
+    EXPECT_EQ(deadline, tickTime + std::chrono::seconds(StateMachine::ERROR_RECOVERY_SECONDS));
+}
+
+// Test Suite: Sampling Report
+class SamplingReportTest : public StateMachineTestFixture {};
+
+TEST_F(SamplingReportTest, CountsTicksSavedAgainstFixedRate) {
+    auto sm = createStateMachine();
+    auto idlePeriod = config.sampling[static_cast<std::size_t>(SystemState::IDLE)].period;
+    // stays below the 30s IDLE auto-start
+    for (int i = 0; i < 5; ++i) {
+        sm->update();
+        clock.advance(idlePeriod);
+    }
+    sm->update();
+    
+    SamplingReport report = sm->samplingReport();
+    EXPECT_EQ(report.ticks[static_cast<std::size_t>(SystemState::IDLE)], 6u);
+    EXPECT_DOUBLE_EQ(report.observed.count(), 5 * std::chrono::duration<double>(idlePeriod).count());
+    EXPECT_DOUBLE_EQ(report.baselineTicks[static_cast<std::size_t>(SystemState::IDLE)],
+                     5.0 * (idlePeriod / StateMachine::TICK_PERIOD));
+    EXPECT_EQ(report.sensorReads, 6u);
+    EXPECT_GT(report.ticksSavedPerDay, 0.0);
+}
+
+TEST_F(SamplingReportTest, EmptyBeforeFirstInterval) {
+    auto sm = createStateMachine();
+    sm->update();
+    
+    SamplingReport report = sm->samplingReport();
+    EXPECT_EQ(report.ticksSavedPerDay, 0.0);
+    EXPECT_EQ(report.cpuSavedPerDay.count(), 0.0);
+}
+
 // Test Suite: Thread Safety
 class ThreadSafetyTest : public StateMachineTestFixture {};
 
@@ -0,0 +1,66 @@
+// tests/unit/test_tick_metrics.cpp
+#include <gtest/gtest.h>
+#include "tick_metrics.hpp"
+#include "test_fixtures.hpp"
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+// Test Suite: Per-state and per-phase tick latency
+class TickMetricsTest : public ::testing::Test {
+protected:
+    static TickTiming timing(SystemState state, std::chrono::nanoseconds sensors, std::chrono::nanoseconds logic) {
+        TickTiming t;
+        t.state = state;
+        t.phase(TickPhase::SENSORS) = sensors;
+        t.phase(TickPhase::LOGIC) = logic;
+        t.total = sensors + logic;
+        return t;
+    }
+
+    TickMetrics metrics;
+};
+
+TEST_F(TickMetricsTest, SeparatesStatesAndPhases) {
+    for (int i = 0; i < 99; ++i) metrics.record(timing(SystemState::WATERING, 2us, 500ns));
+    metrics.record(timing(SystemState::WATERING, 40us, 500ns));
+    metrics.record(timing(SystemState::IDLE, 1us, 100ns));
+    
+    EXPECT_EQ(metrics.total(SystemState::WATERING).count(), 100u);
+    EXPECT_EQ(metrics.total(SystemState::IDLE).count(), 1u);
+    EXPECT_EQ(metrics.total(SystemState::ERROR).count(), 0u);
+    EXPECT_LE(metrics.phase(SystemState::WATERING, TickPhase::SENSORS).percentile(50), 2000ns + 2000ns / 8);
+    EXPECT_EQ(metrics.phase(SystemState::WATERING, TickPhase::SENSORS).max(), 40us);
+    EXPECT_EQ(metrics.phase(SystemState::WATERING, TickPhase::LOGIC).max(), 500ns);
+}
+
+TEST_F(TickMetricsTest, SummaryListsOnlyStatesWithTicks) {
+    metrics.record(timing(SystemState::MONITORING, 3us, 1us));
+    
+    std::string json = metrics.summaryJson();
+    EXPECT_NE(json.find("\"MONITORING\":{\"count\":1"), std::string::npos);
+    EXPECT_NE(json.find("\"max_ns\":4000"), std::string::npos);
+    EXPECT_NE(json.find("\"sensors\":{"), std::string::npos);
+    EXPECT_NE(json.find("\"actuation\":{"), std::string::npos);
+    EXPECT_EQ(json.find("IDLE"), std::string::npos);
+    
+    metrics.reset();
+    EXPECT_EQ(metrics.summaryJson(), "{\"states\":{}}");
+}
+
+// Test Suite: Actuation phase of a real tick
+class TickActuationTest : public StateMachineTestFixture {};
+
+TEST_F(TickActuationTest, PumpSwitchingIsItsOwnPhase) {
+    using ::testing::Invoke;
+    EXPECT_CALL(mockPump, activate()).WillOnce(Invoke([]() { std::this_thread::sleep_for(3ms); }));
+    auto sm = createStateMachine();
+    
+    sm->sendCommnd(Command::ENABLE_MANUAL);
+    sm->update();
+    
+    const TickTiming& t = sm->lastTick();
+    EXPECT_GE(t.phase(TickPhase::ACTUATION), 3ms);
+    EXPECT_LT(t.phase(TickPhase::COMMANDS), 3ms);
+    EXPECT_EQ(t.cause(), TickPhase::ACTUATION);
+}
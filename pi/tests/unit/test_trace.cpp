@@ -0,0 +1,184 @@
+// tests/unit/test_trace.cpp
+#include <gtest/gtest.h>
+#include "trace.hpp"
+#include "trace_replay.hpp"
+#include "simulated_hardware.hpp"
+#include "clock.hpp"
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// Test Suite: Trace format and deterministic replay
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override { spdlog::set_level(spdlog::level::off); }
+    void TearDown() override {
+        std::remove(path.c_str());
+        spdlog::set_level(spdlog::level::info);
+    }
+
+    std::vector<std::uint8_t> readBack() {
+        std::vector<std::uint8_t> bytes;
+        EXPECT_TRUE(TraceReader::load(path, bytes));
+        return bytes;
+    }
+
+    static bool sameStatus(const StatusSnapshot& a, const StatusSnapshot& b) {
+        return a.state == b.state && a.moisture == b.moisture && a.filteredMoisture == b.filteredMoisture &&
+               a.pumpActive == b.pumpActive && a.tick == b.tick && a.timeStamp == b.timeStamp;
+    }
+
+    // one file per test, ctest runs the tests of this suite in parallel processes
+    std::string path = ::testing::TempDir() + "trace_" +
+                       ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".irt";
+};
+
+TEST_F(TraceTest, EventsRoundTrip) {
+    IrrigationConfig config = IrrigationConfig::forSandy("Bed 3");
+    config.sampling[1].burstSamples = 9;
+    SensorFrame frame;
+    frame.moisture = 41.123456789;
+    frame.temperature = 19.5;
+    frame.humidity = 63.0;
+    frame.healthy = true;
+    frame.validate();
+    frame.timeStamp = std::chrono::steady_clock::time_point(12s - 3ms);
+    frame.moistureAge = 250us;
+    {
+        TraceWriter writer(path);
+        ASSERT_TRUE(writer.isOpen());
+        writer.begin(std::chrono::steady_clock::time_point(10s), config);
+        writer.tick(std::chrono::steady_clock::time_point(12s));
+        writer.command(Command::ENABLE_MANUAL);
+        writer.emergencyStop();
+        writer.frame(frame, false);
+        writer.decision(SystemState::ERROR, FlightRecord::PUMP_STOPPED);
+    }
+
+    auto bytes = readBack();
+    TraceReader reader(bytes);
+    ASSERT_TRUE(reader.valid());
+    TraceEvent event;
+
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.type, TraceEventType::BEGIN);
+    EXPECT_EQ(event.time.time_since_epoch(), 10s);
+    EXPECT_EQ(event.config.zoneName, "Bed 3");
+    EXPECT_EQ(event.config.lowMoistureThreshold, 25.0);
+    EXPECT_EQ(event.config.sampling[1].burstSamples, 9);
+    EXPECT_EQ(event.config.sampling[3].period, 60s);
+
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.type, TraceEventType::TICK);
+    EXPECT_EQ(event.time.time_since_epoch(), 12s);
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.command, Command::ENABLE_MANUAL);
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.type, TraceEventType::EMERGENCY_STOP);
+
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.type, TraceEventType::FRAME);
+    EXPECT_EQ(event.frame.moisture, 41.123456789);
+    EXPECT_TRUE(event.frame.healthy);
+    EXPECT_TRUE(event.frame.moistureValid);
+    EXPECT_EQ(event.frame.timeStamp, frame.timeStamp);
+    EXPECT_EQ(event.frame.moistureAge, 250us);
+    EXPECT_FALSE(event.fresh);
+
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.state, SystemState::ERROR);
+    EXPECT_EQ(event.pumpFlags, FlightRecord::PUMP_STOPPED);
+    EXPECT_FALSE(reader.next(event));
+    EXPECT_FALSE(reader.truncated());
+}
+
+TEST_F(TraceTest, ReplayMakesTheRecordedDecisionsEveryTime) {
+    // a simulated day with a dry spell, a config change, manual mode and an e-stop
+    VirtualClock clock;
+    SimulatedHardware hardware(&clock);
+    IrrigationConfig config = IrrigationConfig::forSandy("Trace Zone");
+    std::vector<StatusSnapshot> live;
+    {
+        TraceWriter writer(path);
+        StateMachine machine(&hardware, &hardware, config, &clock);
+        machine.attachTrace(&writer);
+        hardware.setScenario(SimulatedHardware::Scenario::DRY);
+        for (int i = 0; i < 20000 && clock.now().time_since_epoch() < 24h; ++i) {
+            if (i == 50) machine.sendCommnd(Command::START_AUTO);
+            if (i == 3000) { config.highMoistureThreshold = 50.0; machine.updateConfig(config); }
+            if (i == 6000) machine.sendCommnd(Command::ENABLE_MANUAL);
+            if (i == 6020) machine.sendCommnd(Command::DISABLE_MANUAL);
+            if (i == 9000) machine.emergencyStop();
+            hardware.update();
+            machine.update();
+            live.push_back(machine.getStatus());
+            clock.set(machine.nextDeadline());
+        }
+    }
+
+    auto bytes = readBack();
+    std::vector<StatusSnapshot> first;
+    std::vector<StatusSnapshot> second;
+    ReplayResult result = TraceReplay::run(bytes, [&](const StateMachine& m) { first.push_back(m.getStatus()); });
+    TraceReplay::run(bytes, [&](const StateMachine& m) { second.push_back(m.getStatus()); });
+
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(result.divergences, 0u);
+    EXPECT_EQ(result.missingFrames, 0u);
+    EXPECT_EQ(result.unusedFrames, 0u);
+    EXPECT_EQ(result.configChanges, 1u);
+    EXPECT_EQ(result.emergencyStops, 1u);
+    EXPECT_GT(result.pumpStarts, 0u);
+    ASSERT_EQ(first.size(), live.size());
+    ASSERT_EQ(second.size(), live.size());
+    for (std::size_t i = 0; i < live.size(); ++i) {
+        ASSERT_TRUE(sameStatus(first[i], live[i])) << "tick " << i + 1;
+        ASSERT_TRUE(sameStatus(second[i], live[i])) << "tick " << i + 1;
+    }
+}
+
+TEST_F(TraceTest, ReportsDecisionsThatDifferFromTheRecording) {
+    IrrigationConfig config;
+    SensorFrame frame;
+    frame.moisture = 50.0;
+    frame.healthy = true;
+    frame.validate();
+    {
+        TraceWriter writer(path);
+        writer.begin(std::chrono::steady_clock::time_point{}, config);
+        writer.tick(std::chrono::steady_clock::time_point(1s));
+        writer.frame(frame, true);
+        writer.decision(SystemState::IDLE, 0);
+        writer.tick(std::chrono::steady_clock::time_point(2s));
+        writer.frame(frame, true);
+        writer.decision(SystemState::WATERING, FlightRecord::PUMP_STARTED | FlightRecord::PUMP_RUNNING);
+    }
+
+    auto bytes = readBack();
+    ReplayResult result = TraceReplay::run(bytes);
+    EXPECT_EQ(result.ticks, 2u);
+    EXPECT_EQ(result.divergences, 1u);
+    EXPECT_EQ(result.firstDivergence, 2u);
+}
+
+TEST_F(TraceTest, TruncatedTraceIsNotComplete) {
+    {
+        TraceWriter writer(path);
+        writer.begin(std::chrono::steady_clock::time_point{}, IrrigationConfig{});
+        writer.tick(std::chrono::steady_clock::time_point(1s));
+        writer.decision(SystemState::IDLE, 0);
+        SensorFrame frame;
+        writer.frame(frame, true);
+    }
+
+    auto bytes = readBack();
+    bytes.resize(bytes.size() - 5);  // cut into the last frame
+    ReplayResult result = TraceReplay::run(bytes);
+    EXPECT_FALSE(result.complete);
+
+    std::vector<std::uint8_t> foreign(bytes.size(), 0);
+    EXPECT_FALSE(TraceReader(foreign).valid());
+    EXPECT_EQ(TraceReplay::run(foreign).ticks, 0u);
+}
@@ -0,0 +1,81 @@
+// tests/unit/test_triple_buffer.cpp
+#include <gtest/gtest.h>
+#include "triple_buffer.hpp"
+#include <atomic>
+#include <thread>
+
+// Test Suite: Latest-value handoff between two threads
+class TripleBufferTest : public ::testing::Test {};
+
+TEST_F(TripleBufferTest, ReadWithoutWriteIsStale) {
+    TripleBuffer<int> buffer;
+    int value = -1;
+    
+    EXPECT_FALSE(buffer.read(value));
+    EXPECT_EQ(value, -1);
+    EXPECT_EQ(buffer.staleCount(), 1u);
+}
+
+TEST_F(TripleBufferTest, ReadReturnsNewestWrite) {
+    TripleBuffer<int> buffer;
+    buffer.write(1);
+    buffer.write(2);
+    buffer.write(3);
+    
+    int value = 0;
+    ASSERT_TRUE(buffer.read(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_EQ(buffer.droppedCount(), 2u);  // 1 and 2 were never read
+    
+    EXPECT_FALSE(buffer.read(value));       // nothing new since
+    EXPECT_EQ(value, 3);
+}
+
+TEST_F(TripleBufferTest, AlternatingWritesAndReadsDropNothing) {
+    TripleBuffer<int> buffer;
+    int value = 0;
+    for (int i = 0; i < 100; ++i) {
+        buffer.write(i);
+        ASSERT_TRUE(buffer.read(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_EQ(buffer.droppedCount(), 0u);
+    EXPECT_EQ(buffer.staleCount(), 0u);
+}
+
+TEST_F(TripleBufferTest, ConsumerSeesWholeIncreasingFrames) {
+    struct Frame { int id; int copy[15]; };
+    TripleBuffer<Frame> buffer;
+    constexpr int FRAMES = 100000;
+    std::atomic<bool> done{false};
+    
+    std::thread producer([&]() {
+        Frame frame{};
+        for (int i = 1; i <= FRAMES; ++i) {
+            frame.id = i;
+            for (int& c : frame.copy) c = i;
+            buffer.write(frame);
+            if (i % 128 == 0) std::this_thread::yield();
+        }
+        done = true;
+    });
+    
+    int last = 0;
+    int reads = 0;
+    Frame frame{};
+    while (true) {
+        bool finished = done.load();
+        if (!buffer.read(frame)) {
+            if (finished) break;
+            std::this_thread::yield();
+            continue;
+        }
+        ++reads;
+        EXPECT_GT(frame.id, last);
+        for (int c : frame.copy) ASSERT_EQ(c, frame.id);
+        last = frame.id;
+    }
+    producer.join();
+    
+    EXPECT_EQ(static_cast<uint64_t>(reads) + buffer.droppedCount(), static_cast<uint64_t>(FRAMES));
+}
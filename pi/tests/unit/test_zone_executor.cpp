@@ -0,0 +1,131 @@
+// tests/unit/test_zone_executor.cpp
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "mock_interfaces.hpp"
+#include "zone_executor.hpp"
+#include "zone_manager.hpp"
+#include "clock.hpp"
+#include <atomic>
+#include <vector>
+
+// Test Suite: Work-stealing executor
+class ZoneExecutorTest : public ::testing::Test {};
+
+TEST_F(ZoneExecutorTest, RunsEveryTaskExactlyOnce) {
+    ZoneExecutor executor(4);
+    std::vector<std::atomic<int>> runs(1000);
+    
+    for (int batch = 0; batch < 50; ++batch)
+        executor.parallelFor(runs.size(), [&](std::size_t i) { runs[i]++; });
+    
+    for (auto& count : runs)
+        EXPECT_EQ(count.load(), 50);
+}
+
+TEST_F(ZoneExecutorTest, SingleThreadRunsInline) {
+    ZoneExecutor executor(1);
+    std::vector<std::thread::id> ids;
+    
+    executor.parallelFor(10, [&](std::size_t) { ids.push_back(std::this_thread::get_id()); });
+    
+    ASSERT_EQ(ids.size(), 10u);
+    for (auto id : ids)
+        EXPECT_EQ(id, std::this_thread::get_id());
+}
+
+TEST_F(ZoneExecutorTest, IdleWorkersStealFromBusyOnes) {
+    ZoneExecutor executor(4);
+    
+    // Worker 0 owns the slow tasks at the front of the range
+    executor.parallelFor(64, [](std::size_t i) {
+        if (i < 16) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    
+    EXPECT_GT(executor.stealCount(), 0u);
+}
+
+TEST_F(ZoneExecutorTest, BackToBackSmallBatchesNeverLoseTasks) {
+    ZoneExecutor executor(4);
+    std::atomic<int> runs{0};
+    
+    // Tiny batches keep workers stealing while the next batch is being set up
+    for (int batch = 0; batch < 20000; ++batch)
+        executor.parallelFor(3, [&](std::size_t) { runs++; });
+    
+    EXPECT_EQ(runs.load(), 60000);
+}
+
+// Sensor that records whether two zones on its bus ever read at the same time
+class BusSensor : public ISensorInterface {
+public:
+    BusSensor(std::atomic<int>& busUsers, std::atomic<bool>& overlap)
+        : busUsers(busUsers), overlap(overlap) {}
+
+    bool initialize() override { return true; }
+    double getMoisture() override {
+        if (busUsers.fetch_add(1) != 0) overlap = true;
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        busUsers.fetch_sub(1);
+        return 50.0;
+    }
+    double getTemp() override { return 25.0; }
+    double getHumid() override { return 50.0; }
+    bool isRainDetected() override { return false; }
+    bool isHealthy() override { return true; }
+    SensorFrame readAll() override { return readEachChannel(std::chrono::steady_clock::now()); }
+
+private:
+    std::atomic<int>& busUsers;
+    std::atomic<bool>& overlap;
+};
+
+class ParallelZoneManagerTest : public ::testing::Test {
+protected:
+    VirtualClock clock;
+    ZoneManager manager{&clock};
+    ::testing::NiceMock<MockPumpInterface> pump;
+};
+
+TEST_F(ParallelZoneManagerTest, ZonesOnSharedBusNeverOverlap) {
+    std::atomic<int> busUsers{0};
+    std::atomic<bool> overlap{false};
+    std::vector<std::unique_ptr<BusSensor>> sensors;
+    
+    for (int i = 0; i < 16; ++i) {
+        sensors.push_back(std::make_unique<BusSensor>(busUsers, overlap));
+        manager.addZone(IrrigationConfig::forLoam("Zone " + std::to_string(i)), sensors.back().get(), &pump, 1);
+    }
+    
+    ZoneExecutor executor(4);
+    manager.setExecutor(&executor);
+    manager.sendCommandToAll(Command::START_AUTO);
+    for (int tick = 0; tick < 5; ++tick)
+        manager.updateAll();
+    
+    EXPECT_FALSE(overlap.load());
+    for (int i = 0; i < 16; ++i)
+        EXPECT_EQ(manager.zone(i).getCurrentState(), SystemState::MONITORING);
+}
+
+TEST_F(ParallelZoneManagerTest, ParallelUpdateMatchesSequential) {
+    std::vector<std::unique_ptr<::testing::NiceMock<MockSensorInterface>>> sensors;
+    for (int i = 0; i < 32; ++i) {
+        auto sensor = std::make_unique<::testing::NiceMock<MockSensorInterface>>();
+        ON_CALL(*sensor, isHealthy()).WillByDefault(::testing::Return(true));
+        ON_CALL(*sensor, getMoisture()).WillByDefault(::testing::Return(i % 2 ? 10.0 : 50.0));
+        auto config = IrrigationConfig::forLoam("Zone " + std::to_string(i));
+        config.minWateringIntervalMinutes = 0;
+        manager.addZone(config, sensor.get(), &pump);
+        sensors.push_back(std::move(sensor));
+    }
+    
+    ZoneExecutor executor(4);
+    manager.setExecutor(&executor);
+    manager.sendCommandToAll(Command::START_AUTO);
+    for (int tick = 0; tick < 5; ++tick)
+        manager.updateAll();
+    
+    // Dry zones start watering after three low readings, wet zones keep monitoring
+    for (int i = 0; i < 32; ++i)
+        EXPECT_EQ(manager.zone(i).getCurrentState(), i % 2 ? SystemState::WATERING : SystemState::MONITORING);
+}
@@ -0,0 +1,120 @@
+// tests/unit/test_zone_manager.cpp
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "mock_interfaces.hpp"
+#include "zone_manager.hpp"
+#include "clock.hpp"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+// Test Suite: Multi-zone routing and status
+class ZoneManagerTest : public ::testing::Test {
+protected:
+    static constexpr int ZONES = 3;
+
+    void SetUp() override {
+        for (int i = 0; i < ZONES; ++i) {
+            ON_CALL(sensors[i], isHealthy()).WillByDefault(Return(true));
+            ON_CALL(sensors[i], getMoisture()).WillByDefault(Return(50.0 + i));
+            ON_CALL(pumps[i], isActive()).WillByDefault(Return(false));
+            manager.addZone(IrrigationConfig::forLoam("Zone " + std::to_string(i)), &sensors[i], &pumps[i]);
+        }
+    }
+
+    VirtualClock clock;
+    ZoneManager manager{&clock};
+    NiceMock<MockSensorInterface> sensors[ZONES];
+    NiceMock<MockPumpInterface> pumps[ZONES];
+};
+
+TEST_F(ZoneManagerTest, OwnsOneStateMachinePerZone) {
+    EXPECT_EQ(manager.zoneCount(), 3u);
+    EXPECT_EQ(manager.zone(1).getConfig().zoneName, "Zone 1");
+    EXPECT_EQ(manager.zone(1).getConfig().soilType, "Loam");
+}
+
+TEST_F(ZoneManagerTest, ZoneTopicRoutesToSingleZone) {
+    EXPECT_TRUE(manager.handleMessage(ZoneManager::commandTopic(1), "START"));
+    manager.updateAll();
+    
+    EXPECT_EQ(manager.zone(0).getCurrentState(), SystemState::IDLE);
+    EXPECT_EQ(manager.zone(1).getCurrentState(), SystemState::MONITORING);
+    EXPECT_EQ(manager.zone(2).getCurrentState(), SystemState::IDLE);
+}
+
+TEST_F(ZoneManagerTest, SiteTopicRoutesToAllZones) {
+    EXPECT_TRUE(manager.handleMessage("irrigation/command", "STOP"));
+    manager.updateAll();
+    
+    for (int i = 0; i < ZONES; ++i)
+        EXPECT_EQ(manager.zone(i).getCurrentState(), SystemState::ERROR);
+}
+
+TEST_F(ZoneManagerTest, StopMessageCutsPumpBeforeNextTick) {
+    EXPECT_CALL(pumps[2], deactivate()).Times(1);
+    EXPECT_CALL(pumps[0], deactivate()).Times(0);
+    
+    EXPECT_TRUE(manager.handleMessage(ZoneManager::commandTopic(2), "STOP"));
+    ::testing::Mock::VerifyAndClearExpectations(&pumps[2]);
+    EXPECT_TRUE(manager.zone(2).emergencyStopPending());
+}
+
+TEST_F(ZoneManagerTest, RejectsUnknownZonesAndPayloads) {
+    EXPECT_FALSE(manager.handleMessage(ZoneManager::commandTopic(7), "START"));
+    EXPECT_FALSE(manager.handleMessage("irrigation/zones/x/command", "START"));
+    EXPECT_FALSE(manager.handleMessage("irrigation/command", "SCENARIO_DRY"));
+}
+
+TEST_F(ZoneManagerTest, NextDeadlineIsEarliestZone) {
+    manager.sendCommand(0, Command::EMERGENCY_STOP);  // ERROR sleeps for the recovery interval
+    manager.updateAll();
+    
+    EXPECT_EQ(manager.nextDeadline(),
+              clock.now() + DEFAULT_SAMPLING[static_cast<std::size_t>(SystemState::IDLE)].period);
+}
+
+TEST_F(ZoneManagerTest, UpdateDueOnlyTicksZonesWhoseDeadlineArrived) {
+    manager.sendCommand(0, Command::START_AUTO);
+    manager.updateAll();  // zone 0 samples fast in MONITORING, the others idle at 5 s
+    
+    clock.advance(StateMachine::TICK_PERIOD);
+    manager.updateDue();
+    EXPECT_TRUE(manager.ticked(0));
+    EXPECT_FALSE(manager.ticked(1));
+    EXPECT_FALSE(manager.ticked(2));
+    
+    // a command is its own wake-up
+    manager.sendCommand(2, Command::START_AUTO);
+    manager.updateDue();
+    EXPECT_FALSE(manager.ticked(1));
+    EXPECT_TRUE(manager.ticked(2));
+    EXPECT_EQ(manager.zone(2).getCurrentState(), SystemState::MONITORING);
+}
+
+TEST_F(ZoneManagerTest, PublishesStatusPerZone) {
+    manager.updateAll();  // status comes from each zone's last tick
+    
+    std::vector<std::pair<std::string, std::string>> published;
+    manager.publishStatus([&](const std::string& topic, const std::string& payload) {
+        published.emplace_back(topic, payload);
+    });
+    
+    ASSERT_EQ(published.size(), 4u);  // every zone plus the legacy topic for zone 0
+    EXPECT_EQ(published[0].first, "irrigation/status");
+    EXPECT_EQ(published[1].first, "irrigation/zones/0/status");
+    EXPECT_EQ(published[3].first, "irrigation/zones/2/status");
+    EXPECT_NE(published[3].second.find("\"z\":2"), std::string::npos);
+    EXPECT_NE(published[3].second.find("\"m\":52"), std::string::npos);
+}
+
+TEST_F(ZoneManagerTest, StatusDoesNotTouchHardware) {
+    manager.updateAll();
+    
+    EXPECT_CALL(sensors[1], getMoisture()).Times(0);
+    EXPECT_CALL(sensors[1], getTemp()).Times(0);
+    EXPECT_CALL(pumps[1], isActive()).Times(0);
+    
+    std::string status = manager.statusJson(1);
+    EXPECT_NE(status.find("\"m\":51"), std::string::npos);
+}
@@ -0,0 +1,86 @@
+// tools/flight_decode.cpp
+// Prints a flight recorder dump: flight_decode [--csv] <flight_*.bin>
+#include "flight_recorder.hpp"
+#include "state_machine.hpp"
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static const char* stateName(std::uint8_t state)
+{
+    return state < STATE_COUNT ? StateMachine::stateToString(static_cast<SystemState>(state)) : "?";
+}
+
+// one letter per flag, '-' when clear
+static std::string flagString(std::uint8_t flags)
+{
+    std::string text = "------";
+    if (flags & FlightRecord::SENSOR_READ) text[0] = 'R';
+    if (flags & FlightRecord::FRESH_FRAME) text[1] = 'F';
+    if (flags & FlightRecord::PUMP_STARTED) text[2] = 'S';
+    if (flags & FlightRecord::PUMP_STOPPED) text[3] = 'X';
+    if (flags & FlightRecord::PUMP_RUNNING) text[4] = 'P';
+    if (flags & FlightRecord::EMERGENCY_STOP) text[5] = 'E';
+    return text;
+}
+
+// %/min with three decimals, `missing` when there was no trend fit
+static std::string rateText(double rate, const char* missing)
+{
+    if (std::isnan(rate)) return missing;
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", rate);
+    return text;
+}
+
+int main(int argc, char* argv[])
+{
+    bool csv = false;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--csv") csv = true;
+        else path = arg;
+    }
+    if (path.empty()) {
+        std::fprintf(stderr, "usage: %s [--csv] <flight dump>\n", argv[0]);
+        return 2;
+    }
+
+    FlightDumpHeader header;
+    std::vector<FlightRecord> records;
+    if (!FlightRecorder::load(path, header, records)) {
+        std::fprintf(stderr, "%s: not a readable flight recorder dump\n", path.c_str());
+        return 1;
+    }
+
+    // times are shown relative to the newest record
+    std::int64_t last = records.empty() ? 0 : records.back().timeNs;
+    if (csv) {
+        std::printf("tick,t_ms,state,next,moisture,filtered,rate,read_failures,low_readings,config,commands,flags\n");
+    } else {
+        std::printf("zone '%s', %s dump, %u of %llu records\n", header.zone,
+                    header.reason == FlightDumpReason::ERROR ? "ERROR" : "requested",
+                    header.count, static_cast<unsigned long long>(header.recorded));
+        std::printf("%10s %10s %-10s %-10s %8s %8s %8s %4s %4s %4s %3s %s\n",
+                    "tick", "t_ms", "state", "next", "raw", "filt", "%/min", "fail", "low", "cfg", "cmd", "RFSXPE");
+    }
+    for (const FlightRecord& r : records) {
+        double ms = static_cast<double>(r.timeNs - last) / 1e6;
+        if (csv) {
+            std::printf("%llu,%.1f,%s,%s,%.2f,%.2f,%s,%u,%u,%u,%u,%s\n",
+                        static_cast<unsigned long long>(r.tick), ms, stateName(r.state), stateName(r.nextState),
+                        r.moisture, r.filteredMoisture,
+                        rateText(r.changeRate, "").c_str(),
+                        r.readFailures, r.lowReadings, r.configVersion, r.commands, flagString(r.flags).c_str());
+        } else {
+            std::printf("%10llu %10.1f %-10s %-10s %8.2f %8.2f %8s %4u %4u %4u %3u %s\n",
+                        static_cast<unsigned long long>(r.tick), ms, stateName(r.state), stateName(r.nextState),
+                        r.moisture, r.filteredMoisture,
+                        rateText(r.changeRate, "-").c_str(),
+                        r.readFailures, r.lowReadings, r.configVersion, r.commands, flagString(r.flags).c_str());
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+// tools/trace_replay.cpp
+// Replays a recorded zone trace: trace_replay [--verbose] [--repeat=N] <trace_z*.irt>
+// Exits with 3 when a decision differs from the recording, 1 when the trace is unusable.
+#include "trace_replay.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+    bool verbose = false;
+    int repeat = 1;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--verbose") verbose = true;
+        else if (arg.rfind("--repeat=", 0) == 0) {
+            const char* first = arg.data() + 9;
+            const char* last = arg.data() + arg.size();
+            auto [end, ec] = std::from_chars(first, last, repeat);
+            if (ec != std::errc() || end != last) {
+                std::fprintf(stderr, "invalid %s, expected an integer\n", arg.c_str());
+                return 2;
+            }
+            repeat = std::max(1, repeat);
+        }
+        else path = arg;
+    }
+    if (path.empty()) {
+        std::fprintf(stderr, "usage: %s [--verbose] [--repeat=N] <trace>\n", argv[0]);
+        return 2;
+    }
+    // the replayed machine logs like the live one, usually only wanted when chasing an incident
+    spdlog::set_level(verbose ? spdlog::level::info : spdlog::level::off);
+
+    std::vector<std::uint8_t> bytes;
+    if (!TraceReader::load(path, bytes) || !TraceReader(bytes).valid()) {
+        std::fprintf(stderr, "%s: not a readable trace\n", path.c_str());
+        return 1;
+    }
+
+    ReplayResult result;
+    std::chrono::nanoseconds elapsed{0};
+    for (int i = 0; i < repeat; ++i) {
+        result = TraceReplay::run(bytes);
+        elapsed += result.elapsed;
+    }
+    if (result.ticks == 0) {
+        std::fprintf(stderr, "%s: no ticks to replay\n", path.c_str());
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(elapsed).count() / repeat;
+    double simulated = std::chrono::duration<double>(result.simulated).count();
+    std::printf("%s: %llu ticks over %.1f h of clock time%s\n", path.c_str(),
+                static_cast<unsigned long long>(result.ticks), simulated / 3600.0,
+                result.complete ? "" : " (trace incomplete, replayed up to the first hole)");
+    std::printf("  frames %llu, commands %llu, e-stops %llu, config changes %llu\n",
+                static_cast<unsigned long long>(result.frames), static_cast<unsigned long long>(result.commands),
+                static_cast<unsigned long long>(result.emergencyStops),
+                static_cast<unsigned long long>(result.configChanges));
+    std::printf("  transitions %llu, pump starts %llu\n", static_cast<unsigned long long>(result.transitions),
+                static_cast<unsigned long long>(result.pumpStarts));
+    for (std::size_t s = 0; s < STATE_COUNT; ++s) {
+        if (result.ticksPerState[s] == 0) continue;
+        std::printf("  %-10s %llu ticks\n", StateMachine::stateToString(static_cast<SystemState>(s)),
+                    static_cast<unsigned long long>(result.ticksPerState[s]));
+    }
+    std::printf("  replayed in %.3f ms (%.0f ticks/s, %.0fx real time)\n", seconds * 1e3,
+                static_cast<double>(result.ticks) / seconds, seconds > 0 ? simulated / seconds : 0.0);
+    if (result.missingFrames > 0 || result.unusedFrames > 0) {
+        std::printf("  sensor reads without a frame %llu, frames never read %llu\n",
+                    static_cast<unsigned long long>(result.missingFrames),
+                    static_cast<unsigned long long>(result.unusedFrames));
+    }
+    if (result.divergences > 0) {
+        std::printf("  %llu decisions differ from the recording, first at tick %llu\n",
+                    static_cast<unsigned long long>(result.divergences),
+                    static_cast<unsigned long long>(result.firstDivergence));
+        return 3;
+    }
+    std::printf("  every decision matches the recording\n");
+    return 0;
+}